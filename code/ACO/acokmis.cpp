@@ -2,37 +2,67 @@
 
 #include <math.h>
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cmath>
 #include <iostream>
-#include <set>
+#include <random>
 #include <sstream>
 #include <vector>
 
 #include "../Report/report-manager.cpp"
+#include "../Utils/bit_sliced_scorer.cpp"
+#include "../Utils/solution_ids.cpp"
+#include "../Utils/thread_pool.cpp"
 #include "../common.hpp"
 
-
-typedef roaring::Roaring Subset;
-
 const float IMPRECISION = 0.00001;
 
+// Expoentes da regra de transição especializados em tempo de compilação.
+// Os valores padrão (α = 0.5, β = 2) viram sqrt e x * x, sem pow() no laço interno.
+enum class PowKind { ONE, HALF, TWO, THREE, GENERIC };
+
+inline PowKind get_pow_kind(double exponent) {
+  if (exponent == 1.0) return PowKind::ONE;
+  if (exponent == 0.5) return PowKind::HALF;
+  if (exponent == 2.0) return PowKind::TWO;
+  if (exponent == 3.0) return PowKind::THREE;
+  return PowKind::GENERIC;
+}
+
+template <PowKind KIND, typename T>
+inline T pow_by_kind(T x, double exponent) {
+  if constexpr (KIND == PowKind::ONE) {
+    return x;
+  } else if constexpr (KIND == PowKind::HALF) {
+    return std::sqrt(x);
+  } else if constexpr (KIND == PowKind::TWO) {
+    return x * x;
+  } else if constexpr (KIND == PowKind::THREE) {
+    return x * x * x;
+  } else {
+    return std::pow(x, (T)exponent);
+  }
+}
+
+template <typename Subset>
 struct ACOKMISSolution {
-  std::set<int> solution_ids;
-  std::vector<Subset> connections;
-  roaring::Roaring solution;
+  SolutionIds solution_ids;
+  const std::vector<Subset>* connections;  // instância compartilhada, não pertence à solução
+  Subset solution;
 
-  ACOKMISSolution(std::vector<Subset>& connections) : connections(connections) {}
+  ACOKMISSolution(const std::vector<Subset>& connections) : connections(&connections) {}
 
   void add_item_idx(int idx) {
     if (solution_ids.empty()) {
       solution_ids.insert(idx);
-      solution = this->connections[idx];
+      solution = (*this->connections)[idx];
       return;
     }
 
     this->solution_ids.insert(idx);
-    this->solution = this->solution & this->connections[idx];
+    this->solution &= (*this->connections)[idx];
   }
 
   int size() const {
@@ -40,7 +70,7 @@ struct ACOKMISSolution {
   }
 
   bool exist(int idx) const {
-    return this->solution_ids.find(idx) != this->solution_ids.end();
+    return this->solution_ids.contains(idx);
   }
 
   bool empty() const {
@@ -48,200 +78,274 @@ struct ACOKMISSolution {
   }
 };
 
-class ACOKMIS : public ACO {
+// Pontuação gulosa incremental de uma formiga: overlap[j] = |connections[j] ∩ solução parcial|.
+// Como a interseção parcial só diminui, cada passo apenas desconta os elementos removidos;
+// as duas operações pontuam todos os candidatos em lote com o BitSlicedScorer.
+struct GreedyScores {
+  std::vector<int> overlap;
+  int solution_card = 0;
+
+  GreedyScores(int numUsers) : overlap(numUsers, 0) {}
+
+  template <typename Subset>
+  void reset(const Subset& first, const BitSlicedScorer& scorer) {
+    solution_card = first.cardinality();
+    scorer.score_all(first, overlap.data());
+  }
+
+  template <typename Subset>
+  void remove(const Subset& removed, const BitSlicedScorer& scorer) {
+    solution_card -= removed.cardinality();
+    scorer.subtract_scores(removed, overlap.data());
+  }
+};
+
+// Buffers de uma thread de construção, reaproveitados entre formigas e iterações
+struct AntWorkspace {
+  std::vector<float> p;   // probabilidade de escolher cada nó a partir do nó atual
+  std::vector<float> mu;  // pontuação gulosa de cada candidato
+  GreedyScores scores;
+
+  AntWorkspace(int numUsers) : p(numUsers, 0), mu(numUsers, 0), scores(numUsers) {}
+};
+
+struct KernelBenchAccess;  // Benchmarks/kernels.cpp
+
+template <typename Subset = roaring::Roaring>
+class ACOKMIS : public ACO<Subset> {
  private:
+  using Base = ACO<Subset>;
+  using Base::alpha_;
+  using Base::beta_;
+  using Base::connections;
+  using Base::iter_max_;
+  using Base::numUsers;
+  using Base::pheromone_matrix_;
+  using Base::rho_;
+  using Base::tau_0_;
+
+  using Solution = ACOKMISSolution<Subset>;
+
+  ThreadPool pool_;
+  std::vector<AntWorkspace> workspaces_;  // um por thread do pool
+
+  BitSlicedScorer scorer_;  // instância transposta, para pontuar todos os candidatos de uma vez
+
+  // Acumuladores do depósito (soma de |L[u]| e número de formigas por aresta),
+  // zerados pelo próprio kernel de atualização a cada iteração
+  PheromoneMatrix deposit_sum_;
+  PheromoneMatrix deposit_count_;
+
+  // τ^α, recalculado uma vez por iteração após a atualização do feromônio
+  PheromoneMatrix tau_alpha_;
+
+  template <PowKind ALPHA>
+  void refresh_tau_alpha() {
+    const double* tau = pheromone_matrix_.data();
+    double* tau_alpha = tau_alpha_.data();
+    const std::size_t total = pheromone_matrix_.buffer_size();
+
+    for (std::size_t idx = 0; idx < total; idx++) {
+      tau_alpha[idx] = pow_by_kind<ALPHA>(tau[idx], this->alpha_);
+    }
+  }
+
+  void refresh_tau_alpha() {
+    switch (get_pow_kind(this->alpha_)) {
+      case PowKind::ONE: refresh_tau_alpha<PowKind::ONE>(); break;
+      case PowKind::HALF: refresh_tau_alpha<PowKind::HALF>(); break;
+      case PowKind::TWO: refresh_tau_alpha<PowKind::TWO>(); break;
+      case PowKind::THREE: refresh_tau_alpha<PowKind::THREE>(); break;
+      default: refresh_tau_alpha<PowKind::GENERIC>(); break;
+    }
+  }
+
   // Implementações
   void init_pheromone_matrix() {
-    pheromone_matrix_.assign(numUsers, std::vector<double>(numUsers, tau_0_));
+    pheromone_matrix_.assign(numUsers, tau_0_);
+    deposit_sum_.assign(numUsers, 0);
+    deposit_count_.assign(numUsers, 0);
+    tau_alpha_.assign(numUsers, 0);
+    refresh_tau_alpha();
 
 // Verificação apenas em modo debug
 #ifndef NDEBUG
     assert(!pheromone_matrix_.empty() && "Pheromone matrix should not be empty");
-    assert(pheromone_matrix_[0][0] == tau_0_ && "Pheromone matrix not initialized correctly");
+    assert(pheromone_matrix_(0, 0) == tau_0_ && "Pheromone matrix not initialized correctly");
 #endif
   }
-  int tamanho_intersec(std::set<int> s) {
-    Subset intersec = connections[*(s.begin())];  // primeiro elem
-    for (int i : s) {
-      intersec = intersec & this->connections[i];
-    }
-    return intersec.cardinality();
+
+  int get_next_element_by_max_p(const Solution& ant, const std::vector<float>& p) const {
+    int j_maxp = -1;
+
+    for (int j = 0; j < numUsers; j++)
+      if (!ant.exist(j)) {
+        if (j_maxp == -1 || p[j] > p[j_maxp]) {
+          j_maxp = j;
+        }
+      }
+
+    return j_maxp;
   }
 
-  uint32_t get_next_element(std::vector<pair<float, int>>& j_prob) const {
-    int n = sz(j_prob);
-    if (n == 0) return 0;
-    if (n == 1) return j_prob[0].second;
+  // Constrói a formiga iniciada em u até atingir k elementos.
+  // Lê apenas pheromone_matrix_, então várias formigas podem ser construídas em paralelo,
+  // cada uma com o AntWorkspace da sua thread.
+  // BETA fixa o cálculo de η^β em tempo de compilação (ver select_construct_ant).
+  template <PowKind BETA>
+  void construct_ant(Solution& ant, int u, int k, AntWorkspace& ws) const {
+    std::vector<float>& p = ws.p;
+    std::vector<float>& mu = ws.mu;
+    GreedyScores& scores = ws.scores;
 
-    // Criar soma acumulada
-    std::vector<float> prob_acc(n);
-    prob_acc[0] = j_prob[0].first;
-    
-    for (int it = 1; it < n; it++) {
-      prob_acc[it] = prob_acc[it - 1] + j_prob[it].first;
-    }
+    ant.add_item_idx(u);
+    scores.reset(ant.solution, scorer_);
 
-    float x;
+    int i = u;
 
-#ifdef __linux__
-    x = drand48();  // Linux
-#elif _WIN32
-    x = (float)rand() / RAND_MAX;  // Windows
-#else
-#error "OS not supported!"
-#endif
+    while (sz(ant) < k) {
+      const double* tau_alpha_i = tau_alpha_.row(i);
 
-    float normalized_x = x * prob_acc[n - 1];
+      // calcula pontuação gulosa
+      const float solution_card = scores.solution_card;
 
-    // Binary search
-    int l = 0;
-    int r = n - 1;
+      for (int j = 0; j < numUsers; j++)
+        if (!ant.exist(j)) {
+          mu[j] = (float)scores.overlap[j] / solution_card;
+        }
 
-    while (l < r) {
-      int mid = l + ((r - l) >> 1);
+      // calcula probabilidade
+      float sum = 0;
+      for (int j = 0; j < numUsers; j++)
+        if (!ant.exist(j)) {
+          p[j] = tau_alpha_i[j] * pow_by_kind<BETA>(mu[j], this->beta_);
+          sum += p[j];
+        }
+      for (int j = 0; j < numUsers; j++)
+        if (!ant.exist(j)) {
+          p[j] = p[j] / sum;
+        }
 
-      if (prob_acc[mid] >= normalized_x) {
-        r = mid;
-      } else {
-        l = mid + 1;
-      }
+      // A construção é gulosa: sempre o candidato de maior probabilidade, então o ACO não usa
+      // números aleatórios e as repetições de uma instância dão o mesmo resultado
+      int next_element_idx = get_next_element_by_max_p(ant, p);
+      scores.remove(ant.solution - connections[next_element_idx], scorer_);
+      ant.add_item_idx(next_element_idx);
+      i = next_element_idx;
     }
+  }
+
+  using ConstructAntFn = void (ACOKMIS::*)(Solution&, int, int, AntWorkspace&) const;
 
-    return j_prob[l].second;
+  ConstructAntFn select_construct_ant() const {
+    switch (get_pow_kind(this->beta_)) {
+      case PowKind::ONE: return &ACOKMIS::construct_ant<PowKind::ONE>;
+      case PowKind::HALF: return &ACOKMIS::construct_ant<PowKind::HALF>;
+      case PowKind::TWO: return &ACOKMIS::construct_ant<PowKind::TWO>;
+      case PowKind::THREE: return &ACOKMIS::construct_ant<PowKind::THREE>;
+      default: return &ACOKMIS::construct_ant<PowKind::GENERIC>;
+    }
   }
 
-  int get_next_element_by_max_p(std::vector<ACOKMISSolution>& L, std::vector<std::vector<std::vector<float>>>& p, int u, int i) const {
-    int j_maxp = -1;
+  // Atualização do feromônio ao fim de uma iteração, a partir das formigas L e de |best|
+  void update_pheromones(const std::vector<Solution>& L, int best_card) {
+    // Depósito: cada par (i, j) de L[u] acumula |L[u]|
+    for (const Solution& ant : L) {
+      const double ant_card = ant.solution.cardinality();
 
-    for (int j = 0; j < numUsers; j++)
-      if (!L[u].exist(j)) {
-        if (j_maxp == -1 || p[u][i][j] > p[u][i][j_maxp]) {
-          j_maxp = j;
-        }
+      for (int i : ant.solution_ids) {
+        double* sum_i = deposit_sum_.row(i);
+        double* count_i = deposit_count_.row(i);
+
+        for (int j : ant.solution_ids)
+          if (i != j) {
+            sum_i[j] += ant_card;
+            count_i[j] += 1;
+          }
       }
+    }
 
-    return j_maxp;
+    // Evaporação + média dos depósitos normalizada por |best| em uma única passada.
+    // A diagonal também é atualizada, mas nunca é lida (j nunca pertence à solução de i).
+    evaporate_and_deposit(pheromone_matrix_, deposit_sum_, deposit_count_, 1 - rho_, 1.0 / best_card);
+    refresh_tau_alpha();
   }
 
-  int get_next_element_by_prob(std::vector<ACOKMISSolution>& L, std::vector<std::vector<std::vector<float>>>& p, int u, int i) const {
-    std::vector<pair<float, int>> p_u_j;
+  // Construção de uma formiga isolada (na thread chamadora), usada só por Benchmarks/kernels.cpp
+  // (via KernelBenchAccess). build_ant e update_pheromones exigem reset_pheromones() antes.
+  void reset_pheromones() {
+    init_pheromone_matrix();
+  }
 
-    for (int j = 0; j < numUsers; j++)
-      if (!L[u].exist(j)) {
-        p_u_j.push_back({p[u][i][j], j});
-      }
+  Solution build_ant(int u, int k) {
+    AntWorkspace& ws = workspaces_[0];
 
-    return get_next_element(p_u_j);
+    Solution ant(this->connections);
+    (this->*select_construct_ant())(ant, u, k, ws);
+
+    return ant;
   }
 
+  friend struct KernelBenchAccess;
+
  public:
-  ACOKMIS(std::vector<Subset> connections,
+  // num_threads > 1 (0: todos os núcleos) constrói as formigas em paralelo. O padrão é 1 porque
+  // o ACOKMIS costuma rodar dentro de um pool (BatchRunner), que já ocupa os núcleos.
+  ACOKMIS(const std::vector<Subset>& connections,
           int numUsers,
           int numIterations,
           double alpha = 0.5,
           double beta = 2.0,
           double tau_0 = 1.0,
           double rho = 0.7,
-          int iter_max = 50)
-      : ACO(connections, numUsers, numIterations, alpha, beta, tau_0, rho, iter_max) {
-  }
-
-  std::vector<ReportExecData> solve_kMIS(int k) override {
+          int iter_max = 50,
+          int num_threads = 1)
+      : ACO<Subset>(connections, numUsers, numIterations, alpha, beta, tau_0, rho, iter_max),
+        pool_(num_threads),
+        workspaces_(pool_.size(), AntWorkspace(numUsers)),
+        scorer_(connections) {}
+
+  // Cada formiga construída conta como uma avaliação da função objetivo
+  std::vector<ReportExecData> solve_kMIS(int k, const BudgetSpec& budget_spec = BudgetSpec()) override {
     vector<ReportExecData> reports;
 
     init_pheromone_matrix();
 
-    ACOKMISSolution best(this->connections);
+    const ConstructAntFn construct_ant_fn = select_construct_ant();
+
+    Solution best(this->connections);
 
     int iter = 0;
 
-    std::vector<ACOKMISSolution> L(numUsers, ACOKMISSolution(this->connections));  // soluções de cada formiga
+    std::vector<Solution> L(numUsers, Solution(this->connections));  // soluções de cada formiga
 
-    auto start_time = get_current_time();
+    Budget budget(budget_spec);
 
-    while (40000 > TIME_DIFF(start_time, get_current_time())) {  // limite por tempo
-      for (int u = 0; u < numUsers; u++) {
-        L[u] = ACOKMISSolution(this->connections);  // Reset da solução
-        L[u].add_item_idx(u);
-      }
+    while (!budget.exhausted()) {
+      // Construir cada formiga u em paralelo
+      pool_.parallel_for(numUsers, [&](int u, int worker_id) {
+        AntWorkspace& ws = workspaces_[worker_id];
 
-      std::vector<std::vector<std::vector<float>>> p(numUsers, std::vector<std::vector<float>>(numUsers, std::vector<float>(numUsers, 0)));  // probabilidade de escolher cada nó
+        L[u] = Solution(this->connections);  // Reset da solução
+        (this->*construct_ant_fn)(L[u], u, k, ws);
+      });
 
+      // Redução sequencial em ordem de u: o desempate não depende do escalonamento
       for (int u = 0; u < numUsers; u++) {
-        // Construir cada formiga u
-        int i = u;
-
-        while (sz(L[u]) < k) {
-          // calcula pontuação gulosa
-          std::vector<float> mu(numUsers);
-
-          for (int j = 0; j < numUsers; j++)
-            if (!L[u].exist(j)) {
-              int newAnsCard = connections[j].and_cardinality(L[u].solution);
-
-              mu[j] = (float)newAnsCard / L[u].solution.cardinality();
-            }
-
-          // calcula probabilidade
-          float sum = 0;
-          for (int j = 0; j < numUsers; j++)
-            if (!L[u].exist(j)) {
-              p[u][i][j] = pow(pheromone_matrix_[i][j], this->alpha_) * pow(mu[j], this->beta_);
-              sum += p[u][i][j];
-            }
-          for (int j = 0; j < numUsers; j++)
-            if (!L[u].exist(j)) {
-              p[u][i][j] = p[u][i][j] / sum;
-            }
-
-          // Alternative:
-          int next_element_idx = get_next_element_by_max_p(L, p, u, i);
-          L[u].add_item_idx(next_element_idx);
-          i = next_element_idx;
-        }
-
         // Substitui melhor solução, caso L[u] seja melhor
         if (best.empty() || L[u].solution.cardinality() > best.solution.cardinality()) {
           best = L[u];
         }
       }
 
-      std::vector<std::vector<float>> delta(numUsers, std::vector<float>(numUsers, 0));
-      std::vector<std::vector<int>> Q(numUsers, std::vector<int>(numUsers, 0));
-
-      for (int u = 0; u < numUsers; u++) {
-        int Lu_card = L[u].solution.cardinality();
-
-        for (int i : L[u].solution_ids) {
-          for (int j : L[u].solution_ids)
-            if (i != j) {
-              delta[i][j] = delta[i][j] + Lu_card;
-              Q[i][j]++;
-            }
-        }
-      }
-
       int best_card = best.solution.cardinality();
 
-      for (int i = 0; i < numUsers; i++) {
-        for (int j = 0; j < numUsers; j++)
-          if (i != j && Q[i][j] > 0) {
-            delta[i][j] = delta[i][j] / Q[i][j];
-            delta[i][j] = delta[i][j] / best_card;
-          }
-      }
-
-      for (int i = 0; i < numUsers; i++) {
-        for (int j = 0; j < numUsers; j++)
-          if (i != j) {
-            pheromone_matrix_[i][j] = (1 - rho_) * pheromone_matrix_[i][j] + delta[i][j];
-          }
-      }
+      update_pheromones(L, best_card);
 
-      auto end_time = get_current_time();
-      int elapsed_time = TIME_DIFF(start_time, end_time);
+      budget.count_evaluations(numUsers);
+      budget.report_value(best_card);
 
-      reports.push_back(ReportExecData(best.solution_ids, elapsed_time));
+      reports.push_back(ReportExecData(best.solution_ids, best_card, budget.elapsed_ms(), iter));
 
       iter++;
     }
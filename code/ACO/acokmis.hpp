@@ -3,11 +3,15 @@
 #include <vector>
 
 #include "../Report/report.cpp"
+#include "../Utils/budget.cpp"
 #include "../bibliotecas/roaring.hh"
+#include "./pheromone_matrix.hpp"
 
+// Subset é o tipo dos conjuntos da instância: roaring::Roaring ou DenseSubset<WORDS>
+template <typename Subset>
 class ACO {
  protected:
-  std::vector<roaring::Roaring> connections;
+  const std::vector<Subset>& connections;  // da Instance; deve viver mais que o solver
   double alpha_;
   double beta_;
   double tau_0_;
@@ -15,8 +19,7 @@ class ACO {
   int iter_max_;
   int numUsers;
 
-  std::vector<std::vector<double>>
-      pheromone_matrix_;
+  PheromoneMatrix pheromone_matrix_;
 
  public:
 
@@ -25,7 +28,7 @@ class ACO {
 // Vale destacar que, pelo fato dos algoritmos GRASP REATIVO e VNS REATIVO possuírem
 // componentes de aleatoriedade, estes algoritmos foram executados 10 vezes por instância, e a
 // solução e o tempo de execução considerados, foram obtidos através da média das 10 execuções.
-  ACO(std::vector<roaring::Roaring> connections,
+  ACO(const std::vector<Subset>& connections,
       int numUsers,
       int numIterations,
       double alpha = 0.5,
@@ -43,5 +46,6 @@ class ACO {
 
   virtual ~ACO() = default;
 
-  virtual std::vector<ReportExecData> solve_kMIS(int k) = 0;
+  // Executa até esgotar o orçamento (por padrão 40 s de tempo de parede)
+  virtual std::vector<ReportExecData> solve_kMIS(int k, const BudgetSpec& budget_spec = BudgetSpec()) = 0;
 };
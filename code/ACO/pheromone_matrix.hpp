@@ -0,0 +1,124 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Alocador com alinhamento fixo, para que cada linha comece em uma fronteira de vetor SIMD
+template <typename T, std::size_t Alignment>
+struct AlignedAllocator {
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() = default;
+
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+  }
+
+  void deallocate(T* p, std::size_t) {
+    ::operator delete(p, std::align_val_t(Alignment));
+  }
+
+  bool operator==(const AlignedAllocator&) const { return true; }
+  bool operator!=(const AlignedAllocator&) const { return false; }
+};
+
+// Matriz quadrada n x n armazenada em um único buffer row-major.
+// Cada linha é preenchida até um múltiplo de LANES para que os kernels
+// percorram o buffer inteiro sem tratar sobras no meio das linhas.
+class PheromoneMatrix {
+ public:
+  static constexpr int LANES = 4;  // doubles por registrador AVX2
+
+ private:
+  int n_ = 0;
+  int stride_ = 0;
+  std::vector<double, AlignedAllocator<double, 32>> data_;
+
+ public:
+  PheromoneMatrix() = default;
+
+  void assign(int n, double value) {
+    n_ = n;
+    stride_ = (n + LANES - 1) / LANES * LANES;
+    data_.assign((std::size_t)n_ * stride_, value);
+  }
+
+  void fill(double value) {
+    data_.assign(data_.size(), value);
+  }
+
+  int size() const { return n_; }
+
+  bool empty() const { return n_ == 0; }
+
+  double* row(int i) { return data_.data() + (std::size_t)i * stride_; }
+
+  const double* row(int i) const { return data_.data() + (std::size_t)i * stride_; }
+
+  double& operator()(int i, int j) { return row(i)[j]; }
+
+  double operator()(int i, int j) const { return row(i)[j]; }
+
+  double* data() { return data_.data(); }
+
+  const double* data() const { return data_.data(); }
+
+  // Total de posições do buffer, incluindo o preenchimento das linhas
+  std::size_t buffer_size() const { return data_.size(); }
+};
+
+// Atualização de feromônio em uma passada:
+//   tau = decay * tau + (count > 0 ? (sum / count) * inv_best : 0)
+// e zera sum/count para a próxima iteração. As três matrizes devem ter o mesmo tamanho.
+inline void evaporate_and_deposit(PheromoneMatrix& tau,
+                                  PheromoneMatrix& deposit_sum,
+                                  PheromoneMatrix& deposit_count,
+                                  double decay,
+                                  double inv_best) {
+  double* t = tau.data();
+  double* s = deposit_sum.data();
+  double* c = deposit_count.data();
+  const std::size_t total = tau.buffer_size();
+
+  std::size_t idx = 0;
+
+#ifdef __AVX2__
+  const __m256d v_decay = _mm256_set1_pd(decay);
+  const __m256d v_inv_best = _mm256_set1_pd(inv_best);
+  const __m256d v_zero = _mm256_setzero_pd();
+  const __m256d v_one = _mm256_set1_pd(1.0);
+
+  for (; idx + PheromoneMatrix::LANES <= total; idx += PheromoneMatrix::LANES) {
+    __m256d v_tau = _mm256_load_pd(t + idx);
+    __m256d v_sum = _mm256_load_pd(s + idx);
+    __m256d v_count = _mm256_load_pd(c + idx);
+
+    __m256d has_deposit = _mm256_cmp_pd(v_count, v_zero, _CMP_GT_OQ);
+    __m256d delta = _mm256_div_pd(v_sum, _mm256_max_pd(v_count, v_one));
+    delta = _mm256_and_pd(has_deposit, _mm256_mul_pd(delta, v_inv_best));
+
+    _mm256_store_pd(t + idx, _mm256_add_pd(_mm256_mul_pd(v_tau, v_decay), delta));
+    _mm256_store_pd(s + idx, v_zero);
+    _mm256_store_pd(c + idx, v_zero);
+  }
+#endif
+
+  for (; idx < total; idx++) {
+    const double delta = c[idx] > 0 ? (s[idx] / c[idx]) * inv_best : 0;
+    t[idx] = decay * t[idx] + delta;
+    s[idx] = 0;
+    c[idx] = 0;
+  }
+}
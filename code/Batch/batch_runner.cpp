@@ -0,0 +1,422 @@
+#ifndef BATCH_RUNNER_CPP
+#define BATCH_RUNNER_CPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "../ACO/acokmis.cpp"
+#include "../GRASPTS/graspts.cpp"
+#include "../GRASPTS/instance_i.cpp"
+#include "../GRASPTS/shared_best.cpp"
+#include "../Intances/instances.cpp"
+#include "../Report/report-manager.cpp"
+#include "../Utils/budget.cpp"
+#include "../Utils/counter_rng.cpp"
+#include "../Utils/cpu_affinity.cpp"
+#include "../Utils/dense_subset.cpp"
+#include "../Utils/thread_pool.cpp"
+#include "../common.hpp"
+
+enum class Algorithm { GRASPTS, ACO_KMIS };
+
+// Uma execução (algoritmo, instância, repetição)
+struct BatchJob {
+  int group_idx;
+  int repetition;
+};
+
+// Todas as repetições de um algoritmo em uma instância. O relatório é gravado
+// pela thread que termina a última repetição, com as linhas em ordem de repetição.
+struct BatchJobGroup {
+  Algorithm algorithm;
+  const Instance* instance;
+  std::vector<std::vector<ReportExecData>> results;  // por repetição
+  std::atomic<int> remaining;
+  SharedBest shared_best;  // usado apenas pelo GRASPTs cooperativo
+
+  BatchJobGroup(Algorithm algorithm, const Instance* instance, int repetitions)
+      : algorithm(algorithm),
+        instance(instance),
+        results(repetitions),
+        remaining(repetitions) {}
+};
+
+// Instância carregada do stream e os seus grupos (um por algoritmo com repetições > 0).
+// Sai da memória quando o último grupo é gravado.
+struct ResidentInstance {
+  Instance instance;
+  std::vector<std::unique_ptr<BatchJobGroup>> groups;
+  std::atomic<int> remaining_groups{0};
+
+  explicit ResidentInstance(Instance instance) : instance(std::move(instance)) {}
+};
+
+// Job ainda não despachado no modo stream
+struct StreamJob {
+  ResidentInstance* resident;
+  BatchJobGroup* group;
+  int repetition;
+};
+
+// Escalonador da campanha completa: distribui os jobs (algoritmo, instância, repetição)
+// em um pool com uma thread por núcleo permitido ao processo (allowed_cpus), fixando cada
+// worker no seu núcleo. Por padrão cada job roda em uma única thread (aco_threads = 1), então
+// as execuções com limite de tempo não sofrem com excesso de threads. Com aco_threads > 1 cada
+// ACO constrói as formigas nessa quantidade de threads e só começa quando há núcleos livres para
+// todas: um job ocupa 1 núcleo, um ACO ocupa aco_threads, e o total nunca passa do pool.
+//
+// A thread que chama run() trabalha como worker 0 e recupera a afinidade original ao final.
+// A thread de escrita dos relatórios e as leituras em prefetch não ficam fixas e dividem os
+// núcleos com os workers: passam quase todo o tempo esperando o disco, e com
+// BudgetClock::THREAD_CPU não entram no tempo medido dos jobs.
+//
+// As instâncias podem vir todas de uma vez (vector) ou de um InstanceStream. No segundo caso
+// a janela é deslizante: no máximo `window` instâncias ficam residentes (mais as que o stream
+// estiver lendo em prefetch), e a próxima instância é admitida assim que os jobs das residentes
+// acabam de ser despachados e há vaga, sem esperar a janela inteira terminar.
+class BatchRunner {
+ private:
+  ReportManager& graspts_report_manager;
+  ReportManager& aco_report_manager;
+
+  int graspts_repetitions;
+  int aco_repetitions;
+  bool graspts_cooperative;
+  SubsetBackend subset_backend;
+  BudgetSpec budget_spec;
+  uint64_t rng_seed;  // semente da campanha; cada job do GRASPTs usa a chave (rng_seed, instância, repetição)
+  int aco_threads;    // threads de cada execução do ACOKMIS, em [1, pool.size()]
+
+  // Valor alvo por instância (nome do arquivo), sobrepõe budget_spec.target_value
+  std::unordered_map<std::string, int> target_values;
+
+  std::vector<int> cpus;  // núcleos permitidos ao processo; o worker i fica em cpus[i % |cpus|]
+  ThreadPool pool;
+
+  // Núcleos livres quando aco_threads > 1. Os pedidos são atendidos em ordem de chegada, para
+  // que um ACO não espere indefinidamente enquanto jobs de 1 núcleo tomam cada vaga que abre.
+  std::mutex cores_mtx;
+  std::condition_variable cores_freed;
+  int free_cores = 0;
+  uint64_t next_ticket = 0;
+  uint64_t serving_ticket = 0;
+
+  std::vector<std::unique_ptr<BatchJobGroup>> groups;
+  std::vector<BatchJob> jobs;
+  int total_jobs = 0;
+
+  // Estado do modo stream (protegido por stream_mtx)
+  std::mutex stream_mtx;
+  std::condition_variable slot_freed;
+  std::list<std::unique_ptr<ResidentInstance>> resident;
+  std::deque<StreamJob> pending_jobs;
+  bool stream_done = false;
+  int peak_resident = 0;
+
+  void add_jobs(const std::vector<Instance>& instances, Algorithm algorithm, int repetitions) {
+    for (const Instance& instance : instances) {
+      groups.push_back(std::make_unique<BatchJobGroup>(algorithm, &instance, repetitions));
+
+      for (int rep = 0; rep < repetitions; rep++) {
+        jobs.push_back({sz(groups) - 1, rep});
+      }
+    }
+  }
+
+  // Os solvers são instanciados com o Subset escolhido por with_subset_backend; no caso
+  // denso as conexões são convertidas por job (poucos KB, contra segundos de execução).
+  std::vector<ReportExecData> run_job(BatchJobGroup& group, int repetition) {
+    const Instance& instance = *group.instance;
+
+    return with_subset_backend(subset_backend, instance.get_num_elements_r(), [&](auto tag) {
+      using Subset = typename decltype(tag)::type;
+
+      if constexpr (std::is_same_v<Subset, roaring::Roaring>) {
+        return run_job(group, repetition, instance.get_connections());
+      } else {
+        const std::vector<Subset> connections = to_dense_subsets<Subset>(instance.get_connections());
+        return run_job(group, repetition, connections);
+      }
+    });
+  }
+
+  BudgetSpec instance_budget_spec(const Instance& instance) const {
+    BudgetSpec spec = budget_spec;
+
+    auto it = target_values.find(instance.get_file_name());
+    if (it != target_values.end()) spec.target_value = it->second;
+
+    return spec;
+  }
+
+  template <typename Subset>
+  std::vector<ReportExecData> run_job(BatchJobGroup& group, int repetition, const std::vector<Subset>& connections) {
+    const Instance& instance = *group.instance;
+    const BudgetSpec spec = instance_budget_spec(instance);
+    const RngKey rng_key(rng_seed, RngKey::hash_name(instance.get_file_name()), repetition);
+
+    if (group.algorithm == Algorithm::ACO_KMIS) {
+      ACOKMIS<Subset> aco_kmis(
+          connections,
+          instance.get_num_elements_l(),
+          instance.get_num_elements_r(),
+          0.5, 2.0, 1.0, 0.7, 50,
+          aco_threads);
+
+      return aco_kmis.solve_kMIS(instance.get_k(), spec);
+    }
+
+    InstanceI<Subset> I = make_instance_i(instance.get_k(), connections);
+    GRASPTs<Subset> graspts(I, rng_key, graspts_cooperative ? &group.shared_best : nullptr);
+
+    return graspts.solve_kMIS(spec);
+  }
+
+  void save_group(BatchJobGroup& group) {
+    const Instance& instance = *group.instance;
+
+    std::vector<ReportExecData> results;
+
+    for (auto& result : group.results) {
+      results.insert(results.end(), result.begin(), result.end());
+    }
+
+    Report report_instance(instance.get_shared_connections(),
+                           instance.get_file_name(),
+                           instance.get_k(),
+                           std::move(results));
+
+    ReportManager& report_manager = group.algorithm == Algorithm::ACO_KMIS ? aco_report_manager : graspts_report_manager;
+    report_manager.add_reports(std::move(report_instance));
+
+    // Libera a memória das repetições já gravadas
+    group.results.clear();
+    group.results.shrink_to_fit();
+  }
+
+  void pin_worker(int worker_id) {
+    if (!cpus.empty()) pin_current_thread_to_cpu(cpus[worker_id % sz(cpus)]);
+  }
+
+  void acquire_cores(int n) {
+    std::unique_lock<std::mutex> lock(cores_mtx);
+
+    const uint64_t ticket = next_ticket++;
+    cores_freed.wait(lock, [&] { return ticket == serving_ticket && free_cores >= n; });
+
+    free_cores -= n;
+    serving_ticket++;
+    cores_freed.notify_all();
+  }
+
+  void release_cores(int n) {
+    std::lock_guard<std::mutex> lock(cores_mtx);
+    free_cores += n;
+    cores_freed.notify_all();
+  }
+
+  // Roda um job no worker. O ACO com aco_threads > 1 solta a afinidade do worker antes de criar
+  // as suas threads (que a herdariam no Linux) e o fixa de volta no núcleo ao terminar.
+  std::vector<ReportExecData> execute(BatchJobGroup& group, int repetition, int worker_id) {
+    if (aco_threads == 1) return run_job(group, repetition);
+
+    const int cores = group.algorithm == Algorithm::ACO_KMIS ? aco_threads : 1;
+    acquire_cores(cores);
+
+    if (cores > 1) pin_current_thread_to_cpus(cpus);
+    std::vector<ReportExecData> results = run_job(group, repetition);
+    if (cores > 1) pin_worker(worker_id);
+
+    release_cores(cores);
+    return results;
+  }
+
+  int jobs_per_instance() const {
+    return graspts_repetitions + aco_repetitions;
+  }
+
+  // Carrega os grupos e os jobs de uma instância recém-lida (com stream_mtx travado)
+  void admit(Instance instance) {
+    auto entry = std::make_unique<ResidentInstance>(std::move(instance));
+    ResidentInstance* r = entry.get();
+
+    for (auto [algorithm, repetitions] : {std::pair{Algorithm::GRASPTS, graspts_repetitions},
+                                          std::pair{Algorithm::ACO_KMIS, aco_repetitions}}) {
+      if (repetitions <= 0) continue;
+
+      r->groups.push_back(std::make_unique<BatchJobGroup>(algorithm, &r->instance, repetitions));
+
+      for (int rep = 0; rep < repetitions; rep++) {
+        pending_jobs.push_back({r, r->groups.back().get(), rep});
+      }
+    }
+
+    if (r->groups.empty()) return;
+
+    r->remaining_groups = sz(r->groups);
+    total_jobs += jobs_per_instance();
+
+    resident.push_back(std::move(entry));
+    peak_resident = std::max(peak_resident, sz(resident));
+  }
+
+  // Próximo job do stream; false quando não há mais nada a despachar. Lê uma nova instância
+  // quando os jobs admitidos acabaram e há vaga na janela, senão espera uma instância sair.
+  bool next_stream_job(InstanceStream& stream, int window, StreamJob& job) {
+    std::unique_lock<std::mutex> lock(stream_mtx);
+
+    while (true) {
+      if (!pending_jobs.empty()) {
+        job = pending_jobs.front();
+        pending_jobs.pop_front();
+        return true;
+      }
+
+      if (stream_done) return false;
+
+      if (sz(resident) < window) {
+        std::optional<Instance> instance = stream.next();
+
+        if (instance) {
+          admit(std::move(*instance));
+        } else {
+          stream_done = true;
+          slot_freed.notify_all();
+        }
+
+        continue;
+      }
+
+      slot_freed.wait(lock);
+    }
+  }
+
+  void release_group(ResidentInstance* r) {
+    if (r->remaining_groups.fetch_sub(1) != 1) return;
+
+    std::lock_guard<std::mutex> lock(stream_mtx);
+    resident.remove_if([&](const std::unique_ptr<ResidentInstance>& entry) { return entry.get() == r; });
+    slot_freed.notify_all();
+  }
+
+  void run_batch(const std::vector<Instance>& instances) {
+    groups.clear();
+    jobs.clear();
+
+    add_jobs(instances, Algorithm::GRASPTS, graspts_repetitions);
+    add_jobs(instances, Algorithm::ACO_KMIS, aco_repetitions);
+
+    const std::vector<int> caller_cpus = current_thread_cpus();
+
+    pool.parallel_for(sz(jobs), [&](int job_idx, int worker_id) {
+      pin_worker(worker_id);
+
+      const BatchJob& job = jobs[job_idx];
+      BatchJobGroup& group = *groups[job.group_idx];
+
+      group.results[job.repetition] = execute(group, job.repetition, worker_id);
+
+      if (group.remaining.fetch_sub(1) == 1) {
+        save_group(group);
+      }
+    });
+
+    pin_current_thread_to_cpus(caller_cpus);
+
+    total_jobs += sz(jobs);
+    groups.clear();
+  }
+
+ public:
+  BatchRunner(ReportManager& graspts_report_manager,
+              ReportManager& aco_report_manager,
+              int graspts_repetitions = 10,
+              int aco_repetitions = 1,
+              bool graspts_cooperative = false,
+              int num_threads = 0,
+              SubsetBackend subset_backend = SubsetBackend::AUTO,
+              const BudgetSpec& budget_spec = BudgetSpec(),
+              uint64_t rng_seed = 0,
+              int aco_threads = 1)
+      : graspts_report_manager(graspts_report_manager),
+        aco_report_manager(aco_report_manager),
+        graspts_repetitions(graspts_repetitions),
+        aco_repetitions(aco_repetitions),
+        graspts_cooperative(graspts_cooperative),
+        subset_backend(subset_backend),
+        budget_spec(budget_spec),
+        rng_seed(rng_seed),
+        cpus(allowed_cpus()),
+        pool(num_threads > 0 ? num_threads : sz(cpus)) {
+    this->aco_threads = aco_threads > 0 ? std::min(aco_threads, pool.size()) : pool.size();
+    free_cores = pool.size();
+  }
+
+  // Valores ótimos (ou melhores conhecidos) por nome de instância: cada execução para ao atingi-lo
+  void set_target_values(std::unordered_map<std::string, int> targets) {
+    target_values = std::move(targets);
+  }
+
+  void run(const std::vector<Instance>& instances) {
+    total_jobs = 0;
+    run_batch(instances);
+
+    cout << "[success]: batch finished, " << total_jobs << " jobs" << endl;
+  }
+
+  // Janela padrão: instâncias suficientes para ocupar o pool, mais uma para cobrir o fim das
+  // residentes (quando só restam as últimas repetições de cada uma)
+  int default_window() const {
+    const int per_instance = std::max(1, jobs_per_instance());
+    return (pool.size() + per_instance - 1) / per_instance + 1;
+  }
+
+  // window <= 0 usa default_window(). Em memória ficam no máximo window instâncias, mais as
+  // que o stream estiver lendo em prefetch.
+  void run(InstanceStream& stream, int window = 0) {
+    if (window <= 0) window = default_window();
+
+    total_jobs = 0;
+    peak_resident = 0;
+    stream_done = false;
+
+    cout << "[log]: instance window " << window << " (at most " << window + stream.get_prefetch()
+         << " instances in memory with prefetch)" << endl;
+
+    const std::vector<int> caller_cpus = current_thread_cpus();
+
+    // Cada worker busca jobs até o stream acabar
+    pool.parallel_for(pool.size(), [&](int, int worker_id) {
+      pin_worker(worker_id);
+
+      StreamJob job;
+
+      while (next_stream_job(stream, window, job)) {
+        BatchJobGroup& group = *job.group;
+
+        group.results[job.repetition] = execute(group, job.repetition, worker_id);
+
+        if (group.remaining.fetch_sub(1) == 1) {
+          save_group(group);
+          release_group(job.resident);
+        }
+      }
+    });
+
+    pin_current_thread_to_cpus(caller_cpus);
+
+    cout << "[success]: batch finished, " << total_jobs << " jobs, peak of " << peak_resident
+         << " resident instances" << endl;
+  }
+};
+
+#endif  // BATCH_RUNNER_CPP
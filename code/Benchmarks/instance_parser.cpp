@@ -0,0 +1,95 @@
+// Benchmark de leitura das instâncias texto: vazão (MB/s) do parser atual (Instance)
+// contra o leitor original baseado em getline + istringstream por linha.
+//
+// Compilar e executar a partir de code/:
+//   g++ -std=c++17 -O3 -march=native -o bench_instance_parser Benchmarks/instance_parser.cpp bibliotecas/roaring.c
+//   ./bench_instance_parser                  (todas as instâncias .txt do Dataset)
+//   ./bench_instance_parser Dataset/type1/classe_1_100_100.txt ...
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../Intances/instances.cpp"
+
+const int REPETITIONS = 5;
+
+// Leitor original, mantido aqui apenas como referência de desempenho
+vector<roaring::Roaring> legacy_read(const string& file_path) {
+  vector<roaring::Roaring> connections;
+  ifstream file(file_path);
+  string line;
+
+  int num_elements_l, num_elements_r, num_edges, k;
+
+  getline(file, line);
+  istringstream iss(line);
+  iss >> num_elements_l >> num_elements_r >> num_edges >> k;
+
+  connections.resize(num_elements_l);
+
+  for (int i = 0; i < num_edges; ++i) {
+    int left_element, right_element;
+    getline(file, line);
+    istringstream edge_iss(line);
+
+    edge_iss >> left_element >> right_element;
+    connections[left_element - 1].add(right_element - 1);
+  }
+
+  return connections;
+}
+
+template <typename Reader>
+double best_seconds(const vector<string>& paths, Reader read) {
+  double best = 1e100;
+
+  for (int rep = 0; rep < REPETITIONS; rep++) {
+    auto start = chrono::steady_clock::now();
+    for (const string& path : paths) read(path);
+    best = min(best, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+  }
+
+  return best;
+}
+
+int main(int argc, char** argv) {
+  vector<string> paths;
+
+  if (argc > 1) {
+    for (int i = 1; i < argc; i++) paths.push_back(argv[i]);
+  } else {
+    for (const string folder : {"type1/", "type2/", "type3/", "type4/"}) {
+      const string folder_path = INSTANCES_DIR + folder;
+      if (!fs::is_directory(folder_path)) continue;
+
+      for (const auto& entry : fs::directory_iterator(folder_path)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+          paths.push_back(entry.path().string());
+        }
+      }
+    }
+  }
+
+  double total_mb = 0;
+  size_t mismatches = 0;
+
+  for (const string& path : paths) {
+    total_mb += fs::file_size(path) / (1024.0 * 1024.0);
+
+    const vector<roaring::Roaring> expected = legacy_read(path);
+    const vector<roaring::Roaring> actual = Instance(path).get_connections();
+    if (expected != actual) mismatches++;
+  }
+
+  const double legacy_s = best_seconds(paths, [](const string& path) { legacy_read(path); });
+  const double current_s = best_seconds(paths, [](const string& path) { Instance instance(path); });
+
+  printf("files=%zu size=%.1fMB mismatches=%zu\n", paths.size(), total_mb, mismatches);
+  printf("legacy  (getline+istringstream): %8.1f MB/s  (%.0f ms)\n", total_mb / legacy_s, legacy_s * 1000);
+  printf("current (mmap+from_chars+addMany): %6.1f MB/s  (%.0f ms)\n", total_mb / current_s, current_s * 1000);
+}
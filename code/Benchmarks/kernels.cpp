@@ -0,0 +1,369 @@
+// Micro-benchmarks dos kernels dos solvers, por instância e por backend (Roaring e, quando |R|
+// cabe, o DenseSubset escolhido por with_subset_backend):
+//   and_cardinality    |F[i] ∩ F[j]| de um par de elementos
+//   calculate_B_prime  primeira consulta a B'(ei) após uma alteração de S, que monta B' de todos
+//                      os ei (inclui a cópia de S que invalida o cache)
+//   swap               Solucao::swap(ei, ej) sem B' em cache (k - 1 interseções)
+//   construir_CRG      uma construção do GRASPTs (GRASPTs::construct)
+//   busca_tabu_sweep   uma varredura completa da vizinhança de troca de S, com o motor que o
+//                      GRASPTs usa no backend (ver graspts.cpp)
+//   busca_tabu         uma Busca Tabu completa a partir de S (GRASPTs::improve)
+//   aco_ant            construção de uma formiga (ACOKMIS::build_ant)
+//   pheromone_update   ACOKMIS::update_pheromones com as |L| formigas de uma iteração
+//
+// S é uma solução do CRG, fixa por instância (RngKey(BENCH_SEED, instância)). Cada kernel é
+// calibrado para que uma repetição dure pelo menos MIN_REPETITION_SECONDS e então medido
+// `repetitions` vezes; o relatório traz mediana, média, desvio padrão, mínimo e máximo de ns/op
+// e ops/s pela mediana.
+//
+// Compilar e executar a partir de code/:
+//   g++ -std=c++17 -O3 -march=native -pthread -o bench_kernels Benchmarks/kernels.cpp bibliotecas/roaring.c
+//   ./bench_kernels                                  (todas as instâncias do Dataset)
+//   ./bench_kernels --json kernels.json --repetitions 20 Dataset/type1/classe_1_100_100.txt ...
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../ACO/acokmis.cpp"
+#include "../GRASPTS/graspts.cpp"
+#include "../GRASPTS/instance_i.cpp"
+#include "../GRASPTS/swap_evaluator.cpp"
+#include "../Intances/instances.cpp"
+#include "../Utils/counter_rng.cpp"
+#include "../Utils/dense_subset.cpp"
+
+const uint64_t BENCH_SEED = 42;
+const int DEFAULT_REPETITIONS = 10;
+const double MIN_REPETITION_SECONDS = 0.01;
+
+// Fases internas dos solvers (privadas; GRASPTs e ACOKMIS declaram este struct como friend)
+struct KernelBenchAccess {
+  template <typename Subset>
+  static Solucao<Subset> construct(GRASPTs<Subset>& graspts) {
+    return graspts.construct();
+  }
+
+  template <typename Subset>
+  static Solucao<Subset> improve(GRASPTs<Subset>& graspts, const Solucao<Subset>& S) {
+    return graspts.improve(S);
+  }
+
+  template <typename Subset>
+  static void reset_pheromones(ACOKMIS<Subset>& aco_kmis) {
+    aco_kmis.reset_pheromones();
+  }
+
+  template <typename Subset>
+  static ACOKMISSolution<Subset> build_ant(ACOKMIS<Subset>& aco_kmis, int u, int k) {
+    return aco_kmis.build_ant(u, k);
+  }
+
+  template <typename Subset>
+  static void update_pheromones(ACOKMIS<Subset>& aco_kmis, const std::vector<ACOKMISSolution<Subset>>& ants, int best_card) {
+    aco_kmis.update_pheromones(ants, best_card);
+  }
+};
+
+volatile uint64_t sink;  // impede que o compilador descarte o trabalho dos kernels
+
+struct KernelResult {
+  std::string instance;
+  std::string backend;
+  int l = 0, r = 0, k = 0;
+  std::string kernel;
+  uint64_t ops_per_repetition = 0;
+  std::vector<double> ns_per_op;  // uma entrada por repetição, em ordem crescente
+  double mean = 0, stddev = 0, median = 0;
+};
+
+double seconds_for(const std::function<void(uint64_t&)>& op, uint64_t ops, uint64_t& checksum) {
+  auto start = std::chrono::steady_clock::now();
+
+  for (uint64_t i = 0; i < ops; i++) op(checksum);
+
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Dobra o número de operações por repetição até passar de MIN_REPETITION_SECONDS, depois mede
+void measure(KernelResult& result, int repetitions, const std::function<void(uint64_t&)>& op) {
+  uint64_t checksum = 0;
+  uint64_t ops = 1;
+
+  while (seconds_for(op, ops, checksum) < MIN_REPETITION_SECONDS) ops *= 2;
+
+  result.ops_per_repetition = ops;
+  result.ns_per_op.clear();
+
+  for (int rep = 0; rep < repetitions; rep++) {
+    result.ns_per_op.push_back(seconds_for(op, ops, checksum) * 1e9 / ops);
+  }
+
+  std::sort(result.ns_per_op.begin(), result.ns_per_op.end());
+
+  const int n = sz(result.ns_per_op);
+  double sum = 0, sum_sq = 0;
+
+  for (double ns : result.ns_per_op) {
+    sum += ns;
+    sum_sq += ns * ns;
+  }
+
+  result.mean = sum / n;
+  result.stddev = n > 1 ? std::sqrt(std::max(0.0, (sum_sq - n * result.mean * result.mean) / (n - 1))) : 0;
+  result.median = n % 2 ? result.ns_per_op[n / 2] : (result.ns_per_op[n / 2 - 1] + result.ns_per_op[n / 2]) / 2;
+
+  sink = sink + checksum;
+}
+
+template <typename Subset>
+std::string backend_name() {
+  if constexpr (std::is_same_v<Subset, roaring::Roaring>) {
+    return "roaring";
+  } else {
+    return "dense" + std::to_string(Subset::CAPACITY);
+  }
+}
+
+template <typename Subset>
+void bench_backend(const Instance& instance, const std::vector<Subset>& F, int repetitions, std::vector<KernelResult>& results) {
+  const int n = sz(F);
+  const int k = instance.get_k();
+  const RngKey rng_key(BENCH_SEED, RngKey::hash_name(instance.get_file_name()));
+
+  InstanceI<Subset> I = make_instance_i(k, F);
+  GRASPTs<Subset> graspts(I, rng_key);
+
+  const Solucao<Subset> S = KernelBenchAccess::construct(graspts);
+  std::vector<int> S_ids(S.get_indices().begin(), S.get_indices().end());
+
+  // Pares (ei ∈ S, ej ∉ S) para o kernel de troca
+  std::vector<std::pair<int, int>> swaps;
+  for (int i = 0; i < sz(S_ids); i++) {
+    for (int e = (S_ids[i] + 1) % n; e != S_ids[i]; e = (e + 1) % n)
+      if (!S.has_element(e)) {
+        swaps.push_back({S_ids[i], e});
+        break;
+      }
+  }
+
+  ACOKMIS<Subset> aco_kmis(F, instance.get_num_elements_l(), instance.get_num_elements_r(),
+                           0.5, 2.0, 1.0, 0.7, 50, 1);
+  KernelBenchAccess::reset_pheromones(aco_kmis);
+
+  std::vector<ACOKMISSolution<Subset>> ants;
+  int best_card = 1;
+  for (int u = 0; u < n; u++) {
+    ants.push_back(KernelBenchAccess::build_ant(aco_kmis, u, k));
+    best_card = std::max(best_card, (int)ants.back().solution.cardinality());
+  }
+
+  auto run = [&](const std::string& kernel, const std::function<void(uint64_t&)>& op) {
+    KernelResult result;
+    result.instance = instance.get_file_name();
+    result.backend = backend_name<Subset>();
+    result.l = n;
+    result.r = instance.get_num_elements_r();
+    result.k = k;
+    result.kernel = kernel;
+
+    measure(result, repetitions, op);
+    results.push_back(result);
+
+    printf("%s,%s,%s,%llu,%.1f,%.1f,%.1f,%.0f\n",
+           result.instance.c_str(),
+           result.backend.c_str(),
+           result.kernel.c_str(),
+           (unsigned long long)result.ops_per_repetition,
+           result.median,
+           result.mean,
+           result.stddev,
+           1e9 / result.median);
+    fflush(stdout);
+  };
+
+  int pair_i = 0, pair_j = 1 % n;
+  run("and_cardinality", [&](uint64_t& checksum) {
+    checksum += F[pair_i].and_cardinality(F[pair_j]);
+
+    if (++pair_j == n) {
+      pair_j = 0;
+      pair_i = (pair_i + 1) % n;
+    }
+  });
+
+  Solucao<Subset> T = S;
+  int next_e = 0;
+  run("calculate_B_prime", [&](uint64_t& checksum) {
+    T = S;
+    checksum += T.calculate_B_prime(S_ids[next_e]).isEmpty();
+    next_e = (next_e + 1) % sz(S_ids);
+  });
+
+  T = S;
+  int next_swap = 0;
+  bool undo = false;
+  if (!swaps.empty()) {
+    run("swap", [&](uint64_t& checksum) {
+      const auto [ei, ej] = swaps[next_swap];
+
+      // Alterna a troca e o seu inverso, então T volta a S a cada duas operações
+      if (undo) {
+        T.swap(ej, ei);
+        next_swap = (next_swap + 1) % sz(swaps);
+      } else {
+        T.swap(ei, ej);
+      }
+
+      undo = !undo;
+      checksum += T.get_valor();
+    });
+  }
+
+  run("construir_CRG", [&](uint64_t& checksum) {
+    checksum += KernelBenchAccess::construct(graspts).get_valor();
+  });
+
+  // Mesmo motor escolhido por GRASPTs::busca_tabu
+  BitSlicedScorer scorer(F);
+  using SweepEvaluator = std::conditional_t<std::is_same_v<Subset, roaring::Roaring>,
+                                            BitSlicedSwapEvaluator<Subset>,
+                                            SubsetSwapEvaluator<Subset>>;
+  SweepEvaluator evaluator = [&]() {
+    if constexpr (std::is_same_v<Subset, roaring::Roaring>) {
+      return SweepEvaluator(scorer);
+    } else {
+      return SweepEvaluator(F);
+    }
+  }();
+
+  run("busca_tabu_sweep", [&](uint64_t& checksum) {
+    evaluator.load(S);
+
+    for (int ei : S_ids) {
+      evaluator.prepare_removal(S, ei);
+
+      for (int ej = 0; ej < n; ej++)
+        if (!S.has_element(ej)) checksum += evaluator.swap_value(ej);
+    }
+  });
+
+  run("busca_tabu", [&](uint64_t& checksum) {
+    checksum += KernelBenchAccess::improve(graspts, S).get_valor();
+  });
+
+  int next_u = 0;
+  run("aco_ant", [&](uint64_t& checksum) {
+    checksum += KernelBenchAccess::build_ant(aco_kmis, next_u, k).size();
+    next_u = (next_u + 1) % n;
+  });
+
+  run("pheromone_update", [&](uint64_t&) {
+    KernelBenchAccess::update_pheromones(aco_kmis, ants, best_card);
+  });
+}
+
+void bench_instance(const Instance& instance, int repetitions, std::vector<KernelResult>& results) {
+  bench_backend(instance, instance.get_connections(), repetitions, results);
+
+  with_subset_backend(SubsetBackend::AUTO, instance.get_num_elements_r(), [&](auto tag) {
+    using Dense = typename decltype(tag)::type;
+
+    if constexpr (!std::is_same_v<Dense, roaring::Roaring>) {
+      const std::vector<Dense> dense_F = to_dense_subsets<Dense>(instance.get_connections());
+      bench_backend(instance, dense_F, repetitions, results);
+    }
+  });
+}
+
+std::string json_escape(const std::string& s) {
+  std::string out;
+
+  for (char c : s) {
+    if (c == '"' || c == '\\') out += '\\';
+    out += c;
+  }
+
+  return out;
+}
+
+bool write_json(const std::string& path, int repetitions, const std::vector<KernelResult>& results) {
+  FILE* file = fopen(path.c_str(), "w");
+  if (!file) return false;
+
+  fprintf(file, "{\n  \"repetitions\": %d,\n  \"min_repetition_seconds\": %g,\n  \"results\": [", repetitions, MIN_REPETITION_SECONDS);
+
+  for (int i = 0; i < sz(results); i++) {
+    const KernelResult& result = results[i];
+
+    fprintf(file, "%s\n    {\"instance\": \"%s\", \"backend\": \"%s\", \"l\": %d, \"r\": %d, \"k\": %d, ",
+            i ? "," : "",
+            json_escape(result.instance).c_str(),
+            result.backend.c_str(),
+            result.l,
+            result.r,
+            result.k);
+
+    fprintf(file, "\"kernel\": \"%s\", \"ops_per_repetition\": %llu, \"ops_per_second\": %.1f, ",
+            result.kernel.c_str(),
+            (unsigned long long)result.ops_per_repetition,
+            1e9 / result.median);
+
+    fprintf(file, "\"ns_per_op\": {\"median\": %.3f, \"mean\": %.3f, \"stddev\": %.3f, \"min\": %.3f, \"max\": %.3f, \"samples\": [",
+            result.median,
+            result.mean,
+            result.stddev,
+            result.ns_per_op.front(),
+            result.ns_per_op.back());
+
+    for (int rep = 0; rep < sz(result.ns_per_op); rep++) {
+      fprintf(file, "%s%.3f", rep ? ", " : "", result.ns_per_op[rep]);
+    }
+
+    fprintf(file, "]}}");
+  }
+
+  fprintf(file, "\n  ]\n}\n");
+
+  return fclose(file) == 0;
+}
+
+int main(int argc, char** argv) {
+  std::string json_path;
+  int repetitions = DEFAULT_REPETITIONS;
+  std::vector<std::string> paths;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--json") && i + 1 < argc) {
+      json_path = argv[++i];
+    } else if (!strcmp(argv[i], "--repetitions") && i + 1 < argc) {
+      repetitions = std::max(1, atoi(argv[++i]));
+    } else {
+      paths.push_back(argv[i]);
+    }
+  }
+
+  if (paths.empty()) paths = IntancesReader().get_instance_paths();
+
+  printf("instance,backend,kernel,ops_per_repetition,median_ns,mean_ns,stddev_ns,ops_per_s\n");
+
+  std::vector<KernelResult> results;
+
+  for (const std::string& path : paths) {
+    bench_instance(Instance(path), repetitions, results);
+  }
+
+  if (!json_path.empty() && !write_json(json_path, repetitions, results)) {
+    fprintf(stderr, "não foi possível escrever %s\n", json_path.c_str());
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,140 @@
+// Memória ocupada pelos bitmaps de cada instância durante uma execução (ACOKMIS + GRASPTs + Report),
+// comparando o modelo anterior com o atual:
+//   before_kb  Instance + solvers + Report, mais as cópias por valor do vector<Subset> que o modelo
+//              anterior mantinha (get_connections() devolvia uma cópia, guardada por ACO, Report e
+//              InstanceI); as cópias são de fato alocadas e medidas
+//   after_kb   Instance + solvers + Report no modelo atual (todos referenciam os bitmaps da Instance)
+//   delta_kb   before_kb - after_kb
+//   peak_kb    pico do modelo atual durante uma execução curta de cada solver (SOLVE_EVALUATIONS avaliações)
+//
+// Só a memória alocada pelo CRoaring é contada (via roaring_init_memory_hook); usa
+// malloc_usable_size, então depende da glibc.
+//
+// Compilar e executar a partir de code/:
+//   g++ -std=c++17 -O3 -march=native -pthread -o bench_memory_usage Benchmarks/memory_usage.cpp bibliotecas/roaring.c
+//   ./bench_memory_usage                      (todas as instâncias do Dataset)
+//   ./bench_memory_usage Dataset/type1/classe_1_100_100.txt ...
+
+#include <malloc.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../ACO/acokmis.cpp"
+#include "../GRASPTS/graspts.cpp"
+#include "../GRASPTS/instance_i.cpp"
+#include "../Intances/instances.cpp"
+#include "../Report/report.cpp"
+
+// Orçamento da execução usada para medir o pico
+const uint64_t SOLVE_EVALUATIONS = 2000;
+
+// Donos de uma cópia das conexões no modelo anterior: ACO::connections, Report::connections e
+// InstanceI::featuresF
+const int LEGACY_COPIES = 3;
+
+std::atomic<long long> live_bytes{0};
+std::atomic<long long> peak_bytes{0};
+
+void add_live_bytes(long long delta) {
+  const long long now = live_bytes += delta;
+  long long peak = peak_bytes;
+
+  while (now > peak && !peak_bytes.compare_exchange_weak(peak, now)) {
+  }
+}
+
+void* counted_malloc(size_t size) {
+  void* p = malloc(size);
+  if (p) add_live_bytes(malloc_usable_size(p));
+  return p;
+}
+
+void* counted_realloc(void* old, size_t size) {
+  const long long old_size = old ? malloc_usable_size(old) : 0;
+  void* p = realloc(old, size);
+  if (p) add_live_bytes((long long)malloc_usable_size(p) - old_size);
+  return p;
+}
+
+void* counted_calloc(size_t count, size_t size) {
+  void* p = calloc(count, size);
+  if (p) add_live_bytes(malloc_usable_size(p));
+  return p;
+}
+
+void counted_free(void* p) {
+  if (p) live_bytes -= malloc_usable_size(p);
+  free(p);
+}
+
+void* counted_aligned_malloc(size_t alignment, size_t size) {
+  void* p = aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+  if (p) add_live_bytes(malloc_usable_size(p));
+  return p;
+}
+
+void bench_instance(const std::string& path) {
+  const long long start = live_bytes;
+
+  Instance instance(path);
+  const long long instance_bytes = live_bytes - start;
+
+  // Todos referenciam os bitmaps da Instance
+  InstanceI I = mapACOInstanceToGRASPTsInstance(instance);
+  GRASPTs graspts(I, 42u);
+  ACOKMIS aco_kmis(instance.get_connections(), instance.get_num_elements_l(), instance.get_num_elements_r(),
+                   0.5, 2.0, 1.0, 0.7, 50, 1);
+  Report report(instance.get_shared_connections(), instance.get_file_name(), instance.get_k(), {});
+
+  const long long after_bytes = live_bytes - start;
+
+  // Modelo anterior: as mesmas estruturas, mais uma cópia das conexões em cada dono
+  long long before_bytes = 0;
+  {
+    std::vector<std::vector<roaring::Roaring>> legacy_copies;
+    for (int i = 0; i < LEGACY_COPIES; i++) legacy_copies.push_back(instance.get_connections());
+
+    before_bytes = live_bytes - start;
+  }
+
+  const BudgetSpec spec{BudgetClock::WALL, 0, SOLVE_EVALUATIONS, -1};
+  peak_bytes = live_bytes.load();
+
+  graspts.solve_kMIS(spec);
+  aco_kmis.solve_kMIS(instance.get_k(), spec);
+
+  const long long peak = peak_bytes - start;
+
+  printf("%s,%d,%.1f,%.1f,%.1f,%.1f,%.2f,%.1f\n",
+         instance.get_file_name().c_str(),
+         instance.get_num_elements_l(),
+         instance_bytes / 1024.0,
+         before_bytes / 1024.0,
+         after_bytes / 1024.0,
+         (before_bytes - after_bytes) / 1024.0,
+         after_bytes ? (double)before_bytes / after_bytes : 0.0,
+         peak / 1024.0);
+}
+
+int main(int argc, char** argv) {
+  roaring_memory_t hook = {counted_malloc, counted_realloc, counted_calloc, counted_free,
+                           counted_aligned_malloc, counted_free};
+  roaring_init_memory_hook(hook);
+
+  printf("instance,l,instance_kb,before_kb,after_kb,delta_kb,reduction,peak_kb\n");
+
+  if (argc > 1) {
+    for (int i = 1; i < argc; i++) bench_instance(argv[i]);
+    return 0;
+  }
+
+  IntancesReader reader = IntancesReader();
+
+  for (const std::string& path : reader.get_instance_paths()) {
+    bench_instance(path);
+  }
+}
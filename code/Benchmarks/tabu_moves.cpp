@@ -0,0 +1,236 @@
+// Micro-benchmark da vizinhança de troca da Busca Tabu: movimentos avaliados por segundo.
+//   antes:    B_2 = B'(ei) & F[ej] materializado, seguido de B_2.cardinality()
+//   roaring:  RoaringSwapEvaluator (and_cardinality, sem alocação)
+//   counter:  CounterSwapEvaluator (contadores por elemento da direita, definido aqui)
+//   dense:    SubsetSwapEvaluator sobre DenseSubset (backend escolhido por with_subset_backend)
+//   sliced:   BitSlicedSwapEvaluator (todas as trocas de um ei em lote), sobre Roaring e sobre DenseSubset
+//
+// Compilar e executar a partir de code/:
+//   g++ -std=c++17 -O3 -march=native -o bench_tabu_moves Benchmarks/tabu_moves.cpp bibliotecas/roaring.c
+//   ./bench_tabu_moves                      (todas as instâncias do Dataset)
+//   ./bench_tabu_moves Dataset/type1/classe_1_100_100.txt ...
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../GRASPTS/swap_evaluator.cpp"
+#include "../Intances/instances.cpp"
+#include "../Utils/dense_subset.cpp"
+
+using Subset = roaring::Roaring;
+
+const int NUM_SOLUTIONS = 5;
+const double MIN_BENCH_SECONDS = 0.05;
+
+// Avaliação original do laço da Busca Tabu, mantida aqui apenas como referência
+struct MaterializedSwapEvaluator {
+  const std::vector<Subset>* F;
+  const Subset* B_prime = nullptr;
+
+  MaterializedSwapEvaluator(const std::vector<Subset>& F) : F(&F) {}
+
+  void load(const Solucao<>&) {}
+
+  void prepare_removal(const Solucao<>& S, int ei) {
+    B_prime = &S.calculate_B_prime(ei);
+  }
+
+  uint64_t swap_value(int ej) const {
+    Subset B_2 = *B_prime & (*F)[ej];
+    return B_2.cardinality();
+  }
+};
+
+// Motor baseado em contadores, mantido aqui só para comparação (o solver não o seleciona; ver a
+// escolha do motor em GRASPTS/graspts.cpp): cover[r] = quantos elementos de S contêm r (r do lado direito).
+// r ∈ (S \ ei) ∪ ej  <=>  r ∈ F[ej] e cover[r] - [r ∈ F[ei]] == k - 1,
+// então cada troca custa apenas uma varredura da lista de adjacência de ej.
+class CounterSwapEvaluator {
+ private:
+  std::vector<std::vector<uint16_t>> adjacency;  // F[e] como lista de elementos da direita
+  std::vector<uint16_t> cover;
+  std::vector<uint8_t> survives;  // survives[r] = r ∈ B'(ei) para o ei preparado
+  int k = 0;
+
+ public:
+  CounterSwapEvaluator() {}
+
+  template <typename Subset>
+  CounterSwapEvaluator(const std::vector<Subset>& F) : adjacency(F.size()) {
+    uint32_t num_elements_r = 0;
+
+    for (int e = 0; e < sz(F); e++) {
+      adjacency[e].reserve(F[e].cardinality());
+
+      for (uint32_t r : F[e]) {
+        adjacency[e].push_back((uint16_t)r);
+        if (r + 1 > num_elements_r) num_elements_r = r + 1;
+      }
+    }
+
+    cover.assign(num_elements_r, 0);
+    survives.assign(num_elements_r, 0);
+  }
+
+  template <typename Subset>
+  void load(const Solucao<Subset>& S) {
+    std::fill(cover.begin(), cover.end(), 0);
+    k = sz(S.get_indices());
+
+    for (int e : S.get_indices()) {
+      for (uint16_t r : adjacency[e]) cover[r]++;
+    }
+  }
+
+  template <typename Subset>
+  void prepare_removal(const Solucao<Subset>&, int ei) {
+    for (int r = 0; r < sz(cover); r++) {
+      survives[r] = cover[r] == k - 1;
+    }
+
+    for (uint16_t r : adjacency[ei]) {
+      survives[r] = cover[r] == k;
+    }
+  }
+
+  uint64_t swap_value(int ej) const {
+    uint64_t value = 0;
+
+    for (uint16_t r : adjacency[ej]) {
+      value += survives[r];
+    }
+
+    return value;
+  }
+
+  void apply_swap(int ei, int ej) {
+    for (uint16_t r : adjacency[ei]) cover[r]--;
+    for (uint16_t r : adjacency[ej]) cover[r]++;
+  }
+};
+
+// Varre a vizinhança completa de cada solução até acumular MIN_BENCH_SECONDS; devolve movimentos/s
+template <typename SwapEvaluator, typename Solution>
+double moves_per_second(SwapEvaluator& evaluator, const std::vector<Solution>& solutions, int n, uint64_t& checksum) {
+  uint64_t moves = 0;
+  double elapsed = 0;
+
+  auto start = std::chrono::steady_clock::now();
+
+  while (elapsed < MIN_BENCH_SECONDS) {
+    for (const Solution& S : solutions) {
+      evaluator.load(S);
+
+      for (int ei : S.get_indices()) {
+        evaluator.prepare_removal(S, ei);
+
+        for (int ej = 0; ej < n; ej++)
+          if (!S.has_element(ej)) {
+            checksum += evaluator.swap_value(ej);
+            moves++;
+          }
+      }
+    }
+
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  return moves / elapsed;
+}
+
+void bench_instance(const Instance& instance) {
+  const std::vector<Subset>& F = instance.get_connections();
+  const int n = sz(F);
+
+  std::mt19937 rng(42);
+  std::vector<Solucao<>> solutions;
+
+  // Soluções gulosas a partir de um elemento aleatório, próximas das visitadas pela Busca Tabu
+  // (soluções totalmente aleatórias têm B'(ei) quase sempre vazio e distorcem a medição)
+  for (int s = 0; s < NUM_SOLUTIONS; s++) {
+    Solucao<> S(F);
+    S.add_item_idx(rng() % n);
+
+    while (sz(S.get_indices()) < instance.get_k()) {
+      int best_e = -1;
+      uint64_t best_card = 0;
+
+      for (int e = 0; e < n; e++)
+        if (!S.has_element(e)) {
+          uint64_t card = S.get_solution().and_cardinality(F[e]);
+          if (best_e == -1 || card > best_card) {
+            best_e = e;
+            best_card = card;
+          }
+        }
+
+      S.add_item_idx(best_e);
+    }
+    solutions.push_back(S);
+  }
+
+  MaterializedSwapEvaluator materialized(F);
+  RoaringSwapEvaluator roaring(F);
+  CounterSwapEvaluator counter(F);
+
+  BitSlicedScorer scorer(F);
+  BitSlicedSwapEvaluator<Subset> sliced(scorer);
+
+  uint64_t checksum_materialized = 0, checksum_roaring = 0, checksum_counter = 0, checksum_dense = 0;
+  uint64_t checksum_sliced = 0, checksum_dense_sliced = 0;
+
+  const double before = moves_per_second(materialized, solutions, n, checksum_materialized);
+  const double after_roaring = moves_per_second(roaring, solutions, n, checksum_roaring);
+  const double after_counter = moves_per_second(counter, solutions, n, checksum_counter);
+  const double after_sliced = moves_per_second(sliced, solutions, n, checksum_sliced);
+  double after_dense_sliced = 0;
+
+  // Mesmas soluções sobre o backend denso (0 quando |R| não cabe em um DenseSubset)
+  const double after_dense = with_subset_backend(SubsetBackend::AUTO, instance.get_num_elements_r(), [&](auto tag) {
+    using Dense = typename decltype(tag)::type;
+
+    if constexpr (std::is_same_v<Dense, roaring::Roaring>) {
+      return 0.0;
+    } else {
+      const std::vector<Dense> dense_F = to_dense_subsets<Dense>(F);
+      std::vector<Solucao<Dense>> dense_solutions;
+
+      for (const Solucao<>& S : solutions) {
+        dense_solutions.emplace_back(dense_F);
+        dense_solutions.back().set_indices(S.get_indices());
+      }
+
+      BitSlicedSwapEvaluator<Dense> dense_sliced(scorer);
+      after_dense_sliced = moves_per_second(dense_sliced, dense_solutions, n, checksum_dense_sliced);
+
+      SubsetSwapEvaluator<Dense> dense(dense_F);
+      return moves_per_second(dense, dense_solutions, n, checksum_dense);
+    }
+  });
+
+  printf("%s,%d,%.0f,%.0f,%.0f,%.0f,%.0f,%.0f\n",
+         instance.get_file_name().c_str(), instance.get_k(), before, after_roaring, after_counter, after_dense,
+         after_sliced, after_dense_sliced);
+}
+
+int main(int argc, char** argv) {
+  printf("instance,k,materialized_moves_s,roaring_moves_s,counter_moves_s,dense_moves_s,sliced_moves_s,dense_sliced_moves_s\n");
+
+  if (argc > 1) {
+    for (int i = 1; i < argc; i++) {
+      bench_instance(Instance(argv[i]));
+    }
+    return 0;
+  }
+
+  IntancesReader reader = IntancesReader();
+
+  InstanceStream stream = reader.stream(-1);  // leitura em paralelo, uma por núcleo
+
+  while (optional<Instance> instance = stream.next()) {
+    bench_instance(*instance);
+  }
+}
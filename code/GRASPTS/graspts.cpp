@@ -5,49 +5,125 @@
 #include <numeric>
 #include <random>
 #include <set>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
 #include "../Report/report-manager.cpp"
+#include "../Utils/budget.cpp"
+#include "../Utils/counter_rng.cpp"
 #include "../bibliotecas/roaring.hh"
 #include "../common.hpp"
 #include "./instance_i.cpp"
+#include "./shared_best.cpp"
 #include "./solution.cpp"
 #include "./stm.cpp"
-
-using Subset = roaring::Roaring;
-
-// Classe Principal GRASPTs
+#include "./swap_evaluator.cpp"
+
+// Escolha do motor da Busca Tabu (medido com Benchmarks/tabu_moves.cpp nas 278 instâncias do Dataset):
+// - com Roaring, o BitSlicedSwapEvaluator (todos os ej de uma vez por ei) supera o
+//   and_cardinality par a par e o motor por contadores em quase todas as instâncias;
+// - com DenseSubset a interseção par a par custa poucas palavras e continua mais rápida,
+//   na Busca Tabu e na função gulosa do CRG.
+// O motor por contadores não é selecionável: em mediana avalia 0,17x os movimentos/s do
+// BitSlicedSwapEvaluator e 0,08x os do DenseSubset. Só ganha em 10 instâncias pequenas da
+// classe 9 (|L| <= 80, densidade ~0,99, até 2,0x contra o Roaring em lote), que o backend
+// AUTO já resolve com DenseSubset, e nenhum limiar de densidade separa esses casos.
+
+struct KernelBenchAccess;  // Benchmarks/kernels.cpp
+
+// Classe Principal GRASPTs.
+// Subset é o tipo dos conjuntos F[e]: roaring::Roaring ou DenseSubset<WORDS> (ver with_subset_backend).
+template <typename Subset = roaring::Roaring>
 class GRASPTs {
  private:
+  using Solution = Solucao<Subset>;
+
   // Parâmetros da Meta-heurística
-  InstanceI I;                   // Instância (E, F, k)
+  InstanceI<Subset> I;           // Instância (E, F, k)
   int IterMax;                   // Delta (Δ) no pseudocódigo (Número de iterações GRASP)
   double alphaRG;                // αRG para CRG (e.g., 0.50, a variante mais eficiente)
   float tenure_tau;              // τ para Busca Tabu (e.g., 0.5 vezes |L| ou constante)
   int maxIterSemMelhoria_gamma;  // γ para Busca Tabu
 
-  Solucao melhorSolucaoGlobal;  // Sb (Best solution found)
-  std::mt19937 rng;             // Gerador de números aleatórios
+  Solution melhorSolucaoGlobal;  // Sb (Best solution found)
+  CounterRng rng;               // Gerador de números aleatórios, reposicionado a cada iteração GRASP
+  int current_iteration = 0;    // Iteração GRASP atual, gravada junto de cada melhoria
+  Budget budget;                // Critérios de parada da execução atual (reiniciado em solve_kMIS)
+
+  // Modo cooperativo (opcional): melhor solução compartilhada com outras execuções paralelas.
+  // Ela muda a trajetória de cada execução em dois pontos:
+  // - antes de uma iteração GRASP, uma solução publicada por outra execução e melhor que Sb
+  //   passa a ser Sb e é o ponto de partida da Busca Tabu dessa iteração (no lugar do CRG);
+  // - na Busca Tabu, um elemento tabu pode sair da solução se a troca supera o melhor valor
+  //   conhecido por todas as execuções (critério de aspiração).
+  // Só são registradas soluções que superam o melhor valor conhecido.
+  SharedBest* shared_best = nullptr;
+
+  // Adota a solução compartilhada se for melhor que Sb; devolve true se adotou
+  bool import_shared_best() {
+    const SharedBest::Snapshot* snapshot = shared_best->get();
+
+    if (snapshot && snapshot->value > melhorSolucaoGlobal.get_valor()) {
+      melhorSolucaoGlobal.set_indices(snapshot->ids);
+      return true;
+    }
+
+    return false;
+  }
+
+  // Nível de aspiração: valor que uma troca com elemento tabu precisa superar para ser aceita.
+  // Fora do modo cooperativo a lista tabu é absoluta, como no Algoritmo 5.
+  uint64_t aspiration_value() const {
+    return std::max<uint64_t>(melhorSolucaoGlobal.get_valor(), shared_best->value());
+  }
+
+  // Pontuação em lote |B ∩ F[j]| de todos os candidatos, usada pelo CRG e pela Busca Tabu
+  BitSlicedScorer scorer;
+  std::vector<int> candidate_scores;
+
+  // Motores de avaliação da vizinhança (ver comentário no início do arquivo)
+  SubsetSwapEvaluator<Subset> subset_evaluator;
+  BitSlicedSwapEvaluator<Subset> sliced_evaluator;
+
+  static constexpr bool ROARING_BACKEND = std::is_same_v<Subset, roaring::Roaring>;
+
+  void init_swap_evaluators() {
+    subset_evaluator = SubsetSwapEvaluator<Subset>(I.featuresF);
+
+    if constexpr (!ROARING_BACKEND) return;
+
+    scorer = BitSlicedScorer(I.featuresF);
+    candidate_scores.assign(scorer.size(), 0);
+    sliced_evaluator = BitSlicedSwapEvaluator<Subset>(scorer);
+  }
 
   /**
    * Auxiliar: Calcula o valor guloso g(c) para o candidato c.
    * g(c) é o número de features que os elementos em S parcial têm em comum com c.
+   * Com Roaring lê candidate_scores, preenchido por pontuar_candidatos para o S parcial atual.
    */
-  int funcaoGuloso(const Subset& S_parcial_indices, int indice_candidato) {
-    return (S_parcial_indices & I.featuresF[indice_candidato]).cardinality();
+  int funcaoGuloso(const Subset& S_parcial_indices, int indice_candidato) const {
+    if constexpr (ROARING_BACKEND) return candidate_scores[indice_candidato];
+
+    return S_parcial_indices.and_cardinality(I.featuresF[indice_candidato]);
+  }
+
+  // candidate_scores[c] = |S parcial ∩ F[c]| para todo c, em uma única passada.
+  // Com DenseSubset a interseção par a par só nos candidatos da RCL é mais barata.
+  void pontuar_candidatos(const Subset& S_parcial_indices) {
+    if constexpr (ROARING_BACKEND) scorer.score_all(S_parcial_indices, candidate_scores.data());
   }
 
   // ====================================================================
   // FASE 1: CONSTRUÇÃO (Construct)
   // Implementa Constructive Random-Greedy (CRG) - Algoritmo 3
   // ====================================================================
-  Solucao construir_CRG(double alphaRG) {
+  Solution construir_CRG(double alphaRG) {
     // Mapeia os passos 1-10 do Algoritmo 3
-    Solucao S(I.featuresF);  // Passo 1: S ← ∅
+    Solution S(I.featuresF);  // Passo 1: S ← ∅
 
-    std::uniform_int_distribution<int> dist(0, I.indicesE.size() - 1);
-    int ie_idx = dist(rng);
+    int ie_idx = rng.uniform_int(I.indicesE.size());
     int ie = I.indicesE[ie_idx];
 
     S.add_item_idx(ie);
@@ -63,11 +139,14 @@ class GRASPTs {
       // Passo 5: RCL ← SelectRandom(CL, αRG · |CL|)
       std::vector<int> RCL = select_random(CL, alphaRG * sz(CL));
 
+      const Subset& S_parcial = S.get_solution();
+      pontuar_candidatos(S_parcial);
+
       int best_element = RCL[0];
-      int best_g = funcaoGuloso(S.get_solution(), RCL[0]);
+      int best_g = funcaoGuloso(S_parcial, RCL[0]);
 
       for (int c = 1; c < sz(RCL); ++c) {
-        int g_c = funcaoGuloso(S.get_solution(), RCL[c]);
+        int g_c = funcaoGuloso(S_parcial, RCL[c]);
         if (g_c > best_g) {
           best_element = RCL[c];
           best_g = g_c;
@@ -81,12 +160,20 @@ class GRASPTs {
     return S;
   }
 
+  // Amostragem por seleção (Knuth, Algoritmo S): mantém a ordem de CL, como std::sample,
+  // mas com o mesmo resultado em qualquer biblioteca padrão
   std::vector<int> select_random(std::vector<int>& CL, int num_elements) {
     std::vector<int> RCL;
-    std::sample(CL.begin(), CL.end(),
-                std::back_inserter(RCL),
-                num_elements,
-                rng);
+    RCL.reserve(std::max(num_elements, 0));
+
+    int remaining = sz(CL);
+
+    for (int i = 0; i < sz(CL) && sz(RCL) < num_elements; i++, remaining--) {
+      if ((int)rng.uniform_int(remaining) < num_elements - sz(RCL)) {
+        RCL.push_back(CL[i]);
+      }
+    }
+
     return RCL;
   }
 
@@ -94,8 +181,19 @@ class GRASPTs {
   // FASE 2: MELHORIA (Improve)
   // Implementa Tabu Search (TS) - Algoritmo 5
   // ====================================================================
-  Solucao busca_tabu(Solucao S, float tau, int gamma, std::vector<ReportExecData>& reports) {
-    Solucao Sb = S;  // Sb ← S (passo 1)
+  Solution busca_tabu(Solution S, float tau, int gamma, std::vector<ReportExecData>& reports) {
+    if constexpr (ROARING_BACKEND) {
+      return busca_tabu(S, tau, gamma, reports, sliced_evaluator);
+    } else {
+      return busca_tabu(S, tau, gamma, reports, subset_evaluator);
+    }
+  }
+
+  template <typename SwapEvaluator>
+  Solution busca_tabu(Solution S, float tau, int gamma, std::vector<ReportExecData>& reports, SwapEvaluator& evaluator) {
+    Solution Sb = S;  // Sb ← S (passo 1)
+
+    evaluator.load(S);
 
     STM STM(tau);   // Memória de Curto Prazo (passo 2)
     int delta = 0;  // Iterações sem melhoria (γ, passo 3)
@@ -108,19 +206,25 @@ class GRASPTs {
 
       std::tuple<int, int, uint64_t> best_move = {-1, -1, -1};
 
-      // Passo 7: for ei ∈ S \ STM do
+      // Passo 7: for ei ∈ S \ STM do (no modo cooperativo, ei tabu só com aspiração)
       for (int ei : S.get_indices()) {
-        if (!STM.isTabu(ei, S.get_indices().size())) {
-          Subset B_1 = S.calculate_B_prime(ei);
+        const bool tabu = STM.isTabu(ei, S.get_indices().size());
+
+        if (!tabu || shared_best) {
+          evaluator.prepare_removal(S, ei);
+
+          const uint64_t min_value = tabu ? std::max<uint64_t>(Sb.get_valor(), aspiration_value()) : Sb.get_valor();
 
           // Passo 8: for ej ∈ E \ S do
           for (int ej : I.indicesE)
             if (!S.has_element(ej)) {
               // Passo 9: ΔkMIS ← kMIS((S \ ei) U ej) - kMIS(S)
-              Subset B_2 = B_1 & I.featuresF[ej];
+              const uint64_t swap_value = evaluator.swap_value(ej);
+              budget.count_evaluations();
 
-              if (B_2.cardinality() > Sb.get_valor()) {
+              if (swap_value > min_value) {
                 S.swap(ei, ej);
+                evaluator.apply_swap(ei, ej);
 
                 improve = true;
 
@@ -128,11 +232,11 @@ class GRASPTs {
                 Sb = S;
                 STM.MarkTabu(ej);
 
-                this->save_report_if_better(Sb, reports, get_current_time());
+                this->save_report_if_better(Sb, reports);
 
                 break;
-              } else if (!improve && B_2.cardinality() > std::get<2>(best_move)) {
-                best_move = std::make_tuple(ei, ej, B_2.cardinality());
+              } else if (!tabu && !improve && swap_value > std::get<2>(best_move)) {
+                best_move = std::make_tuple(ei, ej, swap_value);
               }
             }
 
@@ -143,48 +247,76 @@ class GRASPTs {
       // Passo 10: if ΔkMIS > BestDelta then
       if (!improve && std::get<0>(best_move) >= 0) {
         S.swap(std::get<0>(best_move), std::get<1>(best_move));
+        evaluator.apply_swap(std::get<0>(best_move), std::get<1>(best_move));
         delta++;
         STM.MarkTabu(std::get<1>(best_move));
       } else if (!improve) {
         delta++;  // Nenhum movimento possível
       }
-    } while (delta < gamma);  // Passo 29: until $\Delta = \gamma$
+    } while (delta < gamma && !budget.exhausted());  // Passo 29: until $\Delta = \gamma$
 
     return Sb;
   }
 
-  void save_report_if_better(const Solucao& S, std::vector<ReportExecData>& reports, TimePoint start_time) {
-    if (melhorSolucaoGlobal.get_indices().empty() || S > melhorSolucaoGlobal) {
-      auto elapsed_time = TIME_DIFF(start_time, get_current_time());
+  void save_report_if_better(const Solution& S, std::vector<ReportExecData>& reports) {
+    budget.report_value(S.get_valor());
 
-      reports.push_back(ReportExecData(S.get_indices(), elapsed_time));
+    if (melhorSolucaoGlobal.get_indices().empty() || S > melhorSolucaoGlobal) {
+      reports.push_back(ReportExecData(S.get_indices(), S.get_valor(), budget.elapsed_ms(), current_iteration));
     }
   }
 
+  // Fases do Algoritmo 1 isoladas, usadas só por Benchmarks/kernels.cpp (via KernelBenchAccess):
+  // Construct (uma chamada do CRG) e Improve (uma Busca Tabu completa, sem limite de orçamento:
+  // só γ a encerra; o orçamento da execução é restaurado ao final)
+  Solution construct() {
+    return construir_CRG(alphaRG);
+  }
+
+  Solution improve(const Solution& S) {
+    std::vector<ReportExecData> reports;
+
+    const Budget saved_budget = budget;
+    budget = Budget(BudgetSpec{BudgetClock::WALL, 0, 0, -1});
+
+    Solution improved = busca_tabu(S, tenure_tau, maxIterSemMelhoria_gamma, reports);
+
+    budget = saved_budget;
+    return improved;
+  }
+
+  friend struct KernelBenchAccess;
+
  public:
-  GRASPTs(const InstanceI& instance, int maxIt, double alpha, float tau, int gamma)
+  GRASPTs(const InstanceI<Subset>& instance, int maxIt, double alpha, float tau, int gamma,
+          const RngKey& rng_key = RngKey())
       : I(instance),
         IterMax(maxIt),
         alphaRG(alpha),
         tenure_tau(tau),
         maxIterSemMelhoria_gamma(gamma),
-        rng(std::random_device{}()),
+        rng(rng_key),
         melhorSolucaoGlobal(I.featuresF) {
+    init_swap_evaluators();
   }
 
-  GRASPTs(const InstanceI& instance) : I(instance) {
+  // As soluções guardam um ponteiro para I.featuresF, então o objeto não pode ser copiado
+  GRASPTs(const GRASPTs&) = delete;
+  GRASPTs& operator=(const GRASPTs&) = delete;
+
+  GRASPTs(const InstanceI<Subset>& instance) : GRASPTs(instance, RngKey()) {}
+
+  // rng_key identifica a execução (semente, instância, repetição); shared_best ativa o modo
+  // cooperativo (ver shared_best), que deixa de ser reprodutível por depender da ordem das publicações
+  GRASPTs(const InstanceI<Subset>& instance, const RngKey& rng_key, SharedBest* shared_best = nullptr) : I(instance) {
     IterMax = 1000;
     alphaRG = 0.50;
     tenure_tau = 0.5;
     maxIterSemMelhoria_gamma = 5;
-    rng = std::mt19937(std::random_device{}());
-    melhorSolucaoGlobal = Solucao(I.featuresF);
-  }
-
-  // Verifica se o tempo limite foi alcançado (40 segundos) - para o TCC
-  bool time_limit_reached(TimePoint start_time) {
-    auto elapsed_time = TIME_DIFF(start_time, get_current_time());
-    return elapsed_time >= 40000.0f;  // Limite de 40000 ms (40 segundos)
+    rng = CounterRng(rng_key);
+    melhorSolucaoGlobal = Solution(I.featuresF);
+    this->shared_best = shared_best;
+    init_swap_evaluators();
   }
 
   // Verifica se o limite de iterações foi alcançado
@@ -195,27 +327,41 @@ class GRASPTs {
   /**
    * Método principal para executar o algoritmo GRASPTs.
    * Mapeia o Algoritmo 1: GRASP.
+   * Executa até esgotar o orçamento (por padrão 40 s de tempo de parede, o limite do TCC);
+   * cada solução construída e cada troca avaliada na Busca Tabu contam como uma avaliação.
    */
-  std::vector<ReportExecData> solve_kMIS() {
+  std::vector<ReportExecData> solve_kMIS(const BudgetSpec& budget_spec = BudgetSpec()) {
     vector<ReportExecData> reports;
 
-    auto start_time = get_current_time();
+    budget = Budget(budget_spec);
 
     // Sb ← ∅ (passo 1, inicializado no construtor)
-    for (int i = 0; !time_limit_reached(start_time); ++i) {  // for i ∈ 1 . . . Δ do (passo 2)
-      // 3: S ← Construct(I, α)
-      Solucao S_construida = construir_CRG(alphaRG);
+    for (int i = 0; !budget.exhausted(); ++i) {  // for i ∈ 1 . . . Δ do (passo 2)
+      current_iteration = i;
+      rng.set_position(0, i);  // a iteração i usa sempre a mesma sequência, qualquer que seja a anterior
+
+      // 3: S ← Construct(I, α), ou a solução compartilhada recém-adotada (modo cooperativo)
+      Solution S_construida(I.featuresF);
 
-      this->save_report_if_better(S_construida, reports, start_time);
+      if (shared_best && import_shared_best()) {
+        S_construida = melhorSolucaoGlobal;
+      } else {
+        S_construida = construir_CRG(alphaRG);
+        budget.count_evaluations();
+
+        this->save_report_if_better(S_construida, reports);
+      }
 
       // 4: S' ← Improve(S)
-      Solucao S_melhorada = busca_tabu(S_construida, tenure_tau, maxIterSemMelhoria_gamma, reports);
+      Solution S_melhorada = busca_tabu(S_construida, tenure_tau, maxIterSemMelhoria_gamma, reports);
 
       // 5: if kMIS(S') > kMIS(Sb) then 6: Sb ← S'
       if (S_melhorada > melhorSolucaoGlobal) {
         melhorSolucaoGlobal.set_solucao(S_melhorada);
 
-        this->save_report_if_better(S_melhorada, reports, start_time);
+        if (shared_best) shared_best->publish(melhorSolucaoGlobal.get_indices(), melhorSolucaoGlobal.get_valor());
+
+        this->save_report_if_better(S_melhorada, reports);
       }
     }
 
@@ -3,15 +3,32 @@
 
 #include <vector>
 
+#include "../Intances/instance.model.cpp"
 #include "../bibliotecas/roaring.hh"
 
-using Subset = roaring::Roaring;
-
-// Estrutura I: Representa a instância do problema kMIS (E, F, k)
+// Estrutura I: Representa a instância do problema kMIS (E, F, k).
+// Subset é o tipo dos conjuntos de F (roaring::Roaring ou DenseSubset<WORDS>).
+template <typename Subset = roaring::Roaring>
 struct InstanceI {
   int k;                          // Número de elementos a serem selecionados
   std::vector<int> indicesE;      // Conjunto de índices dos elementos E
-  std::vector<Subset> featuresF;  // Conjunto F de features (indexado pelos índices de E)
+  const std::vector<Subset>& featuresF;  // Conjunto F de features (indexado pelos índices de E), não pertence a I
 };
 
-#endif
\ No newline at end of file
+// F precisa viver mais que a InstanceI (e que o GRASPTs criado a partir dela)
+template <typename Subset>
+InstanceI<Subset> make_instance_i(int k, const std::vector<Subset>& F) {
+  InstanceI<Subset> ni{k, {}, F};
+
+  for (int i = 0; i < (int)F.size(); ++i) {
+    ni.indicesE.push_back(i);
+  }
+
+  return ni;
+}
+
+inline InstanceI<roaring::Roaring> mapACOInstanceToGRASPTsInstance(const Instance& i) {
+  return make_instance_i(i.get_k(), i.get_connections());
+}
+
+#endif
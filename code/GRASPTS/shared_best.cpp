@@ -0,0 +1,60 @@
+#ifndef SHARED_BEST_CPP
+#define SHARED_BEST_CPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../Utils/solution_ids.cpp"
+
+// Melhor solução compartilhada entre execuções paralelas do GRASPTs (modo cooperativo).
+// Leitura sem trava: o ponteiro publicado aponta para um snapshot imutável que só é liberado
+// junto com o SharedBest. A publicação (rara, só em melhorias) é serializada por um mutex.
+class SharedBest {
+ public:
+  struct Snapshot {
+    SolutionIds ids;
+    uint64_t value;
+  };
+
+ private:
+  std::atomic<const Snapshot*> best{nullptr};
+  std::mutex publish_mtx;
+  std::vector<std::unique_ptr<Snapshot>> snapshots;
+
+ public:
+  SharedBest() = default;
+
+  SharedBest(const SharedBest&) = delete;
+  SharedBest& operator=(const SharedBest&) = delete;
+
+  // nullptr enquanto ninguém publicou
+  const Snapshot* get() const {
+    return best.load(std::memory_order_acquire);
+  }
+
+  uint64_t value() const {
+    const Snapshot* current = get();
+    return current ? current->value : 0;
+  }
+
+  // Publica (ids, value) se for melhor que o atual; devolve true se publicou
+  bool publish(const SolutionIds& ids, uint64_t value) {
+    const Snapshot* current = get();
+    if (current && value <= current->value) return false;
+
+    std::lock_guard<std::mutex> lock(publish_mtx);
+
+    current = get();
+    if (current && value <= current->value) return false;
+
+    snapshots.push_back(std::make_unique<Snapshot>(Snapshot{ids, value}));
+    best.store(snapshots.back().get(), std::memory_order_release);
+
+    return true;
+  }
+};
+
+#endif  // SHARED_BEST_CPP
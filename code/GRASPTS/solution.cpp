@@ -1,46 +1,89 @@
 #ifndef SOLUCAO_CPP
 #define SOLUCAO_CPP
 
-#include <set>
 #include <vector>
 
+#include "../Utils/solution_ids.cpp"
 #include "../bibliotecas/roaring.hh"
+#include "../common.hpp"
 
-using Subset = roaring::Roaring;
+// Interseções "deixando um de fora" da solução: B'(e_i) = ∩_{j != i} F[e_j], na ordem de solution_ids.
+// Construído com interseções de sufixo e um prefixo acumulado, ou seja, O(k) operações para todos os e_i.
+// Não é copiado junto com a solução: a cópia começa inválida e é reconstruída sob demanda.
+template <typename Subset>
+struct LeaveOneOutCache {
+  std::vector<Subset> suffix;       // suffix[i] = F[e_i] ∩ ... ∩ F[e_{k-1}]
+  std::vector<Subset> without;      // without[i] = B'(e_i)
+  bool valid = false;
 
-// Classe para gerenciar a Solução (S ou Sb)
+  LeaveOneOutCache() = default;
+
+  LeaveOneOutCache(const LeaveOneOutCache&) {}
+
+  LeaveOneOutCache& operator=(const LeaveOneOutCache&) {
+    valid = false;
+    return *this;
+  }
+};
+
+// Classe para gerenciar a Solução (S ou Sb).
+// Subset é o tipo dos conjuntos F[e]: roaring::Roaring ou DenseSubset<WORDS>.
+template <typename Subset = roaring::Roaring>
 class Solucao {
  private:
-  std::set<int> solution_ids;
-  roaring::Roaring solution;
-  std::vector<Subset> F;  // connections for ACO
+  SolutionIds solution_ids;
+  Subset solution;
+  const std::vector<Subset>* F = nullptr;  // instância compartilhada, não pertence à solução
 
   uint64_t intersection_cardinality = 0;
 
+  mutable LeaveOneOutCache<Subset> leave_one_out;
+
   void calc_solution() {
     int i = 0;
     for (int e : this->solution_ids) {
       if (i) {
-        this->solution &= F[e];
+        this->solution &= (*F)[e];
       } else {
-        this->solution = F[e];
+        this->solution = (*F)[e];
       }
 
       i++;
     }
     this->intersection_cardinality = this->solution.cardinality();
+    this->leave_one_out.valid = false;
   }
 
- public:
-  Solucao() {}
+  void build_leave_one_out() const {
+    const int k = sz(this->solution_ids);
+    const uint16_t* ids = this->solution_ids.begin();
 
-  Solucao(std::vector<Subset>& F) : F(F) {}
+    leave_one_out.suffix.resize(k);
+    leave_one_out.without.resize(k);
 
-  Subset get_solution() const {
-    return this->solution;
+    leave_one_out.suffix[k - 1] = (*F)[ids[k - 1]];
+    for (int i = k - 2; i >= 0; i--) {
+      leave_one_out.suffix[i] = leave_one_out.suffix[i + 1] & (*F)[ids[i]];
+    }
+
+    // k == 1: não há elementos restantes, B' fica vazio
+    leave_one_out.without[0] = k > 1 ? leave_one_out.suffix[1] : Subset();
+
+    Subset prefix = (*F)[ids[0]];
+    for (int i = 1; i < k; i++) {
+      if (i + 1 < k) {
+        leave_one_out.without[i] = prefix & leave_one_out.suffix[i + 1];
+      } else {
+        leave_one_out.without[i] = prefix;
+      }
+      prefix &= (*F)[ids[i]];
+    }
+
+    leave_one_out.valid = true;
   }
 
-  Subset calculate_B_prime(int removed_e) const {
+  // B'(removed_e) calculado do zero, com k - 1 interseções
+  Subset calculate_B_prime_from_scratch(int removed_e) const {
     Subset B_prime;
     bool first = true;
 
@@ -48,22 +91,45 @@ class Solucao {
     for (int e : this->solution_ids) {
       if (removed_e != e) {
         if (first) {
-          B_prime = this->F[e];  // Assume que F é acessível pelo índice e
+          B_prime = (*this->F)[e];  // Assume que F é acessível pelo índice e
           first = false;
         } else {
-          B_prime = B_prime & this->F[e];
+          B_prime &= (*this->F)[e];
         }
       }
     }
     return B_prime;
   }
 
-  void set_solucao(const Solucao S) {
-    this->solution_ids = S.solution_ids;
+ public:
+  Solucao() {}
+
+  Solucao(const std::vector<Subset>& F) : F(&F) {}
+
+  const Subset& get_solution() const {
+    return this->solution;
+  }
+
+  // B'(removed_e) = interseção da solução sem removed_e.
+  // A primeira chamada após uma alteração monta o cache para todos os elementos da solução.
+  const Subset& calculate_B_prime(int removed_e) const {
+    if (!leave_one_out.valid) {
+      build_leave_one_out();
+    }
+
+    return leave_one_out.without[this->solution_ids.index_of(removed_e)];
+  }
+
+  void set_solucao(const Solucao& S) {
+    this->set_indices(S.solution_ids);
+  }
+
+  void set_indices(const SolutionIds& ids) {
+    this->solution_ids = ids;
     this->calc_solution();
   }
 
-  std::set<int> get_indices() const {
+  const SolutionIds& get_indices() const {
     return solution_ids;
   }
 
@@ -71,31 +137,44 @@ class Solucao {
     return intersection_cardinality;
   }
 
-  Subset get_intersection() const {
+  const Subset& get_intersection() const {
     return this->solution;
   }
 
   bool has_element(int e) const {
-    return this->solution_ids.find(e) != this->solution_ids.end();
+    return this->solution_ids.contains(e);
   }
 
+  // Troca ei por ej reaproveitando B'(ei): S' = B'(ei) ∩ F[ej]
   void swap(int ei, int ej) {
+    if (sz(this->solution_ids) == 1) {
+      this->solution = (*F)[ej];
+    } else if (leave_one_out.valid) {
+      this->solution = leave_one_out.without[this->solution_ids.index_of(ei)];
+      this->solution &= (*F)[ej];
+    } else {
+      this->solution = calculate_B_prime_from_scratch(ei);
+      this->solution &= (*F)[ej];
+    }
+
     this->solution_ids.erase(ei);
     this->solution_ids.insert(ej);
-    this->calc_solution();
+    this->intersection_cardinality = this->solution.cardinality();
+    this->leave_one_out.valid = false;
   }
 
   void add_item_idx(int idx) {
+    this->leave_one_out.valid = false;
+
     if (solution_ids.empty()) {
-      solution_ids.insert(solution_ids.end(),
-                          idx);
-      solution = this->F[idx];
+      solution_ids.insert(idx);
+      solution = (*this->F)[idx];
       intersection_cardinality = solution.cardinality();
       return;
     }
 
-    this->solution_ids.insert(this->solution_ids.end(), idx);
-    this->solution = this->solution & this->F[idx];
+    this->solution_ids.insert(idx);
+    this->solution &= (*this->F)[idx];
     intersection_cardinality = solution.cardinality();
   }
 
@@ -104,4 +183,4 @@ class Solucao {
   }
 };
 
-#endif  // SOLUCAO_CPP
\ No newline at end of file
+#endif  // SOLUCAO_CPP
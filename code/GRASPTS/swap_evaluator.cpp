@@ -0,0 +1,73 @@
+#ifndef SWAP_EVALUATOR_CPP
+#define SWAP_EVALUATOR_CPP
+
+#include <cstdint>
+#include <vector>
+
+#include "../Utils/bit_sliced_scorer.cpp"
+#include "../bibliotecas/roaring.hh"
+#include "./solution.cpp"
+
+// Motores de avaliação da vizinhança de troca da Busca Tabu (ei sai de S, ej entra).
+// Ambos têm a mesma interface, usada por GRASPTs::busca_tabu:
+//   load(S)                 sincroniza o motor com a solução S
+//   prepare_removal(S, ei)  fixa o elemento que sai
+//   swap_value(ej)          kMIS((S \ ei) ∪ ej), valor exato
+//   apply_swap(ei, ej)      acompanha um S.swap(ei, ej) já aplicado
+
+// Motor baseado nos próprios conjuntos (Roaring ou DenseSubset): B'(ei) vem do cache da
+// Solucao e é intersectado com F[ej].
+template <typename Subset>
+class SubsetSwapEvaluator {
+ private:
+  const std::vector<Subset>* F = nullptr;
+  const Subset* B_prime = nullptr;
+
+ public:
+  SubsetSwapEvaluator() {}
+
+  SubsetSwapEvaluator(const std::vector<Subset>& F) : F(&F) {}
+
+  void load(const Solucao<Subset>&) {}
+
+  void prepare_removal(const Solucao<Subset>& S, int ei) {
+    B_prime = &S.calculate_B_prime(ei);
+  }
+
+  // |B'(ei) ∩ F[ej]| sem materializar a interseção
+  uint64_t swap_value(int ej) const {
+    return B_prime->and_cardinality((*F)[ej]);
+  }
+
+  void apply_swap(int, int) {}
+};
+
+using RoaringSwapEvaluator = SubsetSwapEvaluator<roaring::Roaring>;
+
+// Motor em lote: ao fixar ei, calcula |B'(ei) ∩ F[ej]| de todos os ej de uma vez com o
+// BitSlicedScorer; swap_value passa a ser só uma leitura.
+template <typename Subset>
+class BitSlicedSwapEvaluator {
+ private:
+  const BitSlicedScorer* scorer = nullptr;
+  std::vector<int> values;
+
+ public:
+  BitSlicedSwapEvaluator() {}
+
+  BitSlicedSwapEvaluator(const BitSlicedScorer& scorer) : scorer(&scorer), values(scorer.size()) {}
+
+  void load(const Solucao<Subset>&) {}
+
+  void prepare_removal(const Solucao<Subset>& S, int ei) {
+    scorer->score_all(S.calculate_B_prime(ei), values.data());
+  }
+
+  uint64_t swap_value(int ej) const {
+    return values[ej];
+  }
+
+  void apply_swap(int, int) {}
+};
+
+#endif  // SWAP_EVALUATOR_CPP
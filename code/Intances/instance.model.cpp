@@ -1,61 +1,330 @@
+#ifndef INSTANCE_MODEL_CPP
+#define INSTANCE_MODEL_CPP
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "../Utils/mapped_file.cpp"
+#include "../Utils/solution_ids.cpp"
 #include "../bibliotecas/roaring.hh"
 
 using namespace std;
 
+// Formato binário pré-compilado (.kmis), gerado por Tools/convert_instances.cpp:
+//   BinaryInstanceHeader                        (48 bytes)
+//   BinaryBitmapEntry entries[num_elements_l]   posição e tamanho de cada bitmap
+//   connections[0 .. l-1]                       formato "frozen" do Roaring, cada um alinhado a 32 bytes
+// O formato frozen é lido sem cópia (a visão aponta direto para o arquivo mapeado) e,
+// ao contrário da leitura congelada do formato portável, mantém os containers alinhados.
+// O cabeçalho guarda tamanho e data de modificação do .txt de origem: se o .txt mudou depois
+// da conversão, o binário é considerado desatualizado e o texto é lido no lugar dele.
+// Inteiros em little-endian (mesma restrição dos formatos do Roaring).
+const char BINARY_INSTANCE_MAGIC[8] = {'K', 'M', 'I', 'S', 'B', 'I', 'N', '\0'};
+const uint32_t BINARY_INSTANCE_VERSION = 2;
+const string BINARY_INSTANCE_EXTENSION = ".kmis";
+const size_t BINARY_INSTANCE_ALIGNMENT = 32;
+
+struct BinaryInstanceHeader {
+  char magic[8];
+  uint32_t version;
+  int32_t num_elements_l;
+  int32_t num_elements_r;
+  int32_t num_edges;
+  int32_t k;
+  uint32_t reserved;
+  uint64_t source_size;   // tamanho do .txt de origem
+  int64_t source_mtime;   // last_write_time do .txt de origem (ticks de filesystem::file_time_type)
+};
+
+struct BinaryBitmapEntry {
+  uint64_t offset;  // a partir do início do arquivo
+  uint64_t size;
+};
+
+static_assert(sizeof(BinaryInstanceHeader) == 48, "BinaryInstanceHeader must have 48 bytes");
+static_assert(sizeof(BinaryBitmapEntry) == 16, "BinaryBitmapEntry must have 16 bytes");
+
+// Bitmap somente leitura que aponta direto para o buffer serializado (sem cópia).
+// O buffer precisa continuar válido enquanto o bitmap existir.
+inline bool frozen_view(const char* buf, size_t size, roaring::Roaring& r) {
+  const roaring::api::roaring_bitmap_t* view = roaring::api::roaring_bitmap_frozen_view(buf, size);
+  if (!view) return false;
+
+  r.roaring = *view;  // o destrutor de Roaring libera a arena de visões congeladas
+  return true;
+}
+
+// Arquivo de instância ausente ou malformado. Lançada pelo construtor de Instance, então
+// nenhuma Instance parcialmente lida chega aos solvers.
+struct InstanceError : runtime_error {
+  using runtime_error::runtime_error;
+};
+
 struct Instance {
  private:
   string file_path;
 
-  int num_elements_l;
-  int num_elements_r;
+  int num_elements_l = 0;
+  int num_elements_r = 0;
+
+  int num_edges = 0;
+  int num_elements_solution = 0;
+
+  int k = 0;
+
+  // Mantém o arquivo .kmis mapeado enquanto as conexões apontarem para ele
+  shared_ptr<MappedFile> mapped_file;
+
+  // Construídas uma única vez e nunca alteradas: cópias da Instance compartilham os mesmos
+  // bitmaps, e solvers/relatórios recebem apenas referências (get_connections)
+  shared_ptr<const vector<roaring::Roaring>> connections = make_shared<const vector<roaring::Roaring>>();
+
+  static size_t align_binary_offset(size_t offset) {
+    return (offset + BINARY_INSTANCE_ALIGNMENT - 1) / BINARY_INSTANCE_ALIGNMENT * BINARY_INSTANCE_ALIGNMENT;
+  }
+
+  // Tamanho e data de modificação do .txt; false se ele não existir
+  static bool source_fingerprint(const string& txt_path, uint64_t& size, int64_t& mtime) {
+    error_code ec;
+
+    size = filesystem::file_size(txt_path, ec);
+    if (ec) return false;
+
+    const auto write_time = filesystem::last_write_time(txt_path, ec);
+    if (ec) return false;
+
+    mtime = write_time.time_since_epoch().count();
+    return true;
+  }
+
+  // As soluções guardam os índices de L em SolutionIds; instâncias maiores não podem ser resolvidas
+  static void check_capacity(int num_elements_l, const string& path) {
+    if (num_elements_l > MAX_SOLUTION_ELEMENTS) {
+      throw InstanceError("|L| = " + std::to_string(num_elements_l) + " exceeds the supported maximum of " +
+                          std::to_string(MAX_SOLUTION_ELEMENTS) + " elements: " + path);
+    }
+  }
+
+  // Valida todo o cabeçalho, a tabela de bitmaps (sem overflow em offset + size) e o conteúdo
+  // contra L/R/arestas antes de aceitar o arquivo; lança InstanceError em qualquer problema
+  void read_from_binary_file(const string& binary_path) {
+    auto file = make_shared<MappedFile>(binary_path);
+
+    if (!file->is_open()) {
+      throw InstanceError("This file cannot be opened: " + binary_path);
+    }
+
+    if (file->size() < sizeof(BinaryInstanceHeader)) {
+      throw InstanceError("truncated binary instance: " + binary_path);
+    }
+
+    BinaryInstanceHeader header;
+    memcpy(&header, file->data(), sizeof(header));
+
+    if (memcmp(header.magic, BINARY_INSTANCE_MAGIC, sizeof(header.magic)) != 0) {
+      throw InstanceError("invalid binary instance: " + binary_path);
+    }
+
+    if (header.version != BINARY_INSTANCE_VERSION) {
+      throw InstanceError("unsupported binary instance version " + std::to_string(header.version) + ": " + binary_path);
+    }
+
+    if (header.num_elements_l < 1 || header.num_elements_r < 0 || header.num_edges < 0 ||
+        header.k < 1 || header.k > header.num_elements_l) {
+      throw InstanceError("invalid binary instance header: " + binary_path);
+    }
+
+    check_capacity(header.num_elements_l, binary_path);
+
+    const size_t num_entries = header.num_elements_l;
+    const size_t table_end = sizeof(header) + num_entries * sizeof(BinaryBitmapEntry);
+
+    if ((file->size() - sizeof(header)) / sizeof(BinaryBitmapEntry) < num_entries) {
+      throw InstanceError("truncated binary instance: " + binary_path);
+    }
+
+    uint64_t source_size;
+    int64_t source_mtime;
+
+    if (source_fingerprint(file_path, source_size, source_mtime) &&
+        (source_size != header.source_size || source_mtime != header.source_mtime)) {
+      throw InstanceError("stale binary instance (" + file_path + " changed after conversion): " + binary_path);
+    }
+
+    vector<roaring::Roaring> bitmaps(num_entries);
+    uint64_t total_cardinality = 0;
+
+    for (size_t i = 0; i < num_entries; ++i) {
+      BinaryBitmapEntry entry;
+      memcpy(&entry, file->data() + sizeof(header) + i * sizeof(BinaryBitmapEntry), sizeof(entry));
 
-  int num_edges;
-  int num_elements_solution;
+      // offset + size comparados separadamente para não estourar em uint64
+      if (entry.offset < table_end || entry.offset > file->size() || entry.size > file->size() - entry.offset ||
+          !frozen_view(file->data() + entry.offset, entry.size, bitmaps[i])) {
+        throw InstanceError("invalid bitmap " + std::to_string(i) + " in binary instance: " + binary_path);
+      }
+
+      if (!bitmaps[i].isEmpty() && bitmaps[i].maximum() >= (uint32_t)header.num_elements_r) {
+        throw InstanceError("bitmap " + std::to_string(i) + " out of bounds in binary instance: " + binary_path);
+      }
+
+      total_cardinality += bitmaps[i].cardinality();
+    }
+
+    // Arestas repetidas no .txt viram um único elemento, então o total pode ser menor
+    if (total_cardinality > (uint64_t)header.num_edges) {
+      throw InstanceError("more elements than edges in binary instance: " + binary_path);
+    }
+
+    num_elements_l = header.num_elements_l;
+    num_elements_r = header.num_elements_r;
+    num_edges = header.num_edges;
+    k = header.k;
+
+    mapped_file = file;
+    connections = make_shared<const vector<roaring::Roaring>>(std::move(bitmaps));
+  }
+
+  // Lê o próximo inteiro a partir de p (pulando espaços e quebras de linha); false no fim ou em lixo
+  static bool parse_next_int(const char*& p, const char* end, int& value) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
 
-  int k;
+    auto [next, ec] = from_chars(p, end, value);
+    if (ec != errc()) return false;
 
-  vector<roaring::Roaring> connections;
+    p = next;
+    return true;
+  }
 
+  // Parser do formato texto: arquivo mapeado inteiro, inteiros lidos com from_chars,
+  // vizinhos agrupados por linha e inseridos de uma vez com addMany.
   void read_from_file() {
-    ifstream file(file_path);
-    string line;
+    MappedFile file(file_path);
 
-    if (file.is_open()) {
-      // Primeira linha - números básicos
-      getline(file, line);
+    if (!file.is_open()) {
+      throw InstanceError("This file cannot be opened: " + file_path);
+    }
+
+    const char* p = file.data();
+    const char* end = p + file.size();
+
+    // Primeira linha - números básicos
+    if (!parse_next_int(p, end, num_elements_l) || !parse_next_int(p, end, num_elements_r) ||
+        !parse_next_int(p, end, num_edges) || !parse_next_int(p, end, k) ||
+        num_elements_l < 1 || num_elements_r < 0 || num_edges < 0 || k < 1 || k > num_elements_l) {
+      throw InstanceError("invalid instance header: " + file_path);
+    }
 
-      istringstream iss(line);
+    check_capacity(num_elements_l, file_path);
 
-      iss >> num_elements_l >> num_elements_r >> num_edges >> k;
+    // Linhas seguintes - conexões
+    vector<vector<uint32_t>> neighbors(num_elements_l);
 
-      // Linhas seguintes - conexões
-      connections.resize(num_elements_l);
+    for (int i = 0; i < num_edges; ++i) {
+      int left_element, right_element;
 
-      for (int i = 0; i < num_edges; ++i) {
-        int left_element, right_element;
-        getline(file, line);
-        istringstream edge_iss(line);
+      if (!parse_next_int(p, end, left_element) || !parse_next_int(p, end, right_element)) {
+        throw InstanceError("expected " + std::to_string(num_edges) + " edges, found " + std::to_string(i) + ": " + file_path);
+      }
 
-        edge_iss >> left_element >> right_element;
-        connections[left_element - 1].add(right_element - 1);
+      if (left_element < 1 || left_element > num_elements_l || right_element < 1 || right_element > num_elements_r) {
+        throw InstanceError("edge " + std::to_string(left_element) + " " + std::to_string(right_element) +
+                            " out of bounds: " + file_path);
       }
 
-      file.close();
-    } else {
-      cerr << "[faild]: This file cannot be opened: " << file_path << endl;
+      neighbors[left_element - 1].push_back(right_element - 1);
     }
+
+    vector<roaring::Roaring> bitmaps(num_elements_l);
+
+    for (int i = 0; i < num_elements_l; ++i) {
+      sort(neighbors[i].begin(), neighbors[i].end());
+      bitmaps[i].addMany(neighbors[i].size(), neighbors[i].data());
+    }
+
+    connections = make_shared<const vector<roaring::Roaring>>(std::move(bitmaps));
   }
 
  public:
+  // Aceita o .txt original ou o binário .kmis. No segundo caso file_path continua sendo
+  // o caminho do .txt, para que os relatórios não dependam do formato carregado.
+  // Um .kmis inválido ou desatualizado é trocado pelo .txt, se ele existir.
+  // Lança InstanceError se o arquivo não existir ou estiver malformado.
   Instance(const string& path) : file_path(path) {
-    read_from_file();
+    if (filesystem::path(path).extension() == BINARY_INSTANCE_EXTENSION) {
+      file_path = filesystem::path(path).replace_extension(".txt").string();
+
+      try {
+        read_from_binary_file(path);
+      } catch (const InstanceError& error) {
+        if (!filesystem::exists(file_path)) throw;
+
+        fprintf(stderr, "[warning]: %s; reading %s instead\n", error.what(), file_path.c_str());
+        read_from_file();
+      }
+    } else {
+      read_from_file();
+    }
+  }
+
+  // Grava a instância no formato binário .kmis; devolve false se o arquivo não pôde ser escrito
+  bool save_binary(const string& binary_path) const {
+    if (num_elements_l < 1 || connections->size() != (size_t)num_elements_l) {
+      fprintf(stderr, "[faild]: instance %s has %d bitmaps, expected %d\n",
+              file_path.c_str(), (int)connections->size(), num_elements_l);
+      return false;
+    }
+
+    vector<BinaryBitmapEntry> entries(num_elements_l);
+
+    size_t offset = align_binary_offset(sizeof(BinaryInstanceHeader) + entries.size() * sizeof(BinaryBitmapEntry));
+    for (int i = 0; i < num_elements_l; ++i) {
+      entries[i].offset = offset;
+      entries[i].size = (*connections)[i].getFrozenSizeInBytes();
+      offset = align_binary_offset(offset + entries[i].size);
+    }
+
+    vector<char> buffer(offset, 0);
+
+    BinaryInstanceHeader header = {};
+    memcpy(header.magic, BINARY_INSTANCE_MAGIC, sizeof(header.magic));
+    header.version = BINARY_INSTANCE_VERSION;
+    header.num_elements_l = num_elements_l;
+    header.num_elements_r = num_elements_r;
+    header.num_edges = num_edges;
+    header.k = k;
+
+    if (!source_fingerprint(file_path, header.source_size, header.source_mtime)) {
+      fprintf(stderr, "[faild]: source file not found: %s\n", file_path.c_str());
+      return false;
+    }
+
+    memcpy(buffer.data(), &header, sizeof(header));
+    memcpy(buffer.data() + sizeof(header), entries.data(), entries.size() * sizeof(BinaryBitmapEntry));
+
+    for (int i = 0; i < num_elements_l; ++i) {
+      (*connections)[i].writeFrozen(buffer.data() + entries[i].offset);
+    }
+
+    ofstream file(binary_path, ios::binary | ios::trunc);
+    if (!file.is_open()) {
+      fprintf(stderr, "[faild]: This file cannot be opened: %s\n", binary_path.c_str());
+      return false;
+    }
+
+    file.write(buffer.data(), buffer.size());
+    return (bool)file;
   }
 
   int get_num_elements_l() const {
@@ -74,8 +343,16 @@ struct Instance {
     return k;
   }
 
-  vector<roaring::Roaring> get_connections() const {
-    return this->connections;
+  // Referência válida enquanto esta Instance (ou uma cópia dela) existir
+  const vector<roaring::Roaring>& get_connections() const {
+    return *this->connections;
+  }
+
+  // Posse compartilhada das conexões (e do arquivo mapeado por trás delas), para quem
+  // precisa usá-las depois que a Instance deixar de existir
+  shared_ptr<const vector<roaring::Roaring>> get_shared_connections() const {
+    auto owner = make_shared<pair<shared_ptr<MappedFile>, shared_ptr<const vector<roaring::Roaring>>>>(mapped_file, connections);
+    return shared_ptr<const vector<roaring::Roaring>>(owner, owner->second.get());
   }
 
   string to_string() const {
@@ -86,3 +363,5 @@ struct Instance {
     return oss.str();
   }
 };
+
+#endif  // INSTANCE_MODEL_CPP
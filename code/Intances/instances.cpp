@@ -1,11 +1,23 @@
+#ifndef INSTANCES_CPP
+#define INSTANCES_CPP
+
+#include <algorithm>
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
+#include <deque>
+#include <future>
 #include <iostream>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "../bibliotecas/roaring.hh"
+#include "../Utils/cpu_affinity.cpp"
+#include "../Utils/thread_pool.cpp"
+#include "../common.hpp"
 #include "instance.model.cpp"
 
 namespace fs = std::filesystem;
@@ -13,46 +25,152 @@ using namespace std;
 
 const string INSTANCES_DIR = "./Dataset/";
 
+// Instâncias inválidas são puladas pelos leitores; o erro vai sempre para stderr
+// (cerr é um stream nulo fora do modo DEBUG)
+inline void log_instance_error(const string& path, const exception& error) {
+  fprintf(stderr, "[faild]: skipping instance %s: %s\n", path.c_str(), error.what());
+}
+
+// Entrega as instâncias uma a uma, na ordem dos caminhos. Com prefetch = N, as N próximas
+// instâncias são lidas em paralelo em threads de fundo enquanto as atuais são resolvidas,
+// então a leitura escala com os núcleos e, além das instâncias entregues, no máximo N ficam
+// em memória. prefetch = 0 lê cada instância na chamada de next(). Instâncias que não podem
+// ser lidas são puladas (com o erro em stderr).
+class InstanceStream {
+ private:
+  vector<string> paths;
+  size_t next_idx = 0;     // próxima instância a ser entregue
+  size_t next_start = 0;   // próxima instância a ser lida em prefetch
+  int prefetch;
+  vector<int> cpus;  // núcleos de quem criou o stream, onde rodam as leituras em prefetch
+  deque<future<Instance>> pending;  // leituras em andamento, na ordem de paths
+
+  static Instance load(const string& path) {
+    return Instance(path);
+  }
+
+  void start_prefetch() {
+    while (sz(pending) < prefetch && next_start < paths.size()) {
+      // A thread nova herdaria a afinidade de quem chamou next(), que pode ser um worker fixo
+      // em um núcleo (BatchRunner); a leitura volta para os núcleos de quem criou o stream
+      pending.push_back(async(launch::async, [path = paths[next_start++], cpus = cpus] {
+        pin_current_thread_to_cpus(cpus);
+        return load(path);
+      }));
+    }
+  }
+
+ public:
+  // prefetch < 0 usa uma leitura em paralelo por núcleo
+  InstanceStream(vector<string> paths, int prefetch = 1)
+      : paths(std::move(paths)), prefetch(prefetch), cpus(current_thread_cpus()) {
+    if (this->prefetch < 0) this->prefetch = std::max(1u, std::thread::hardware_concurrency());
+
+    start_prefetch();
+  }
+
+  InstanceStream(const InstanceStream&) = delete;
+  InstanceStream& operator=(const InstanceStream&) = delete;
+
+  // Próxima instância válida, ou nullopt quando todas já foram entregues
+  optional<Instance> next() {
+    while (next_idx < paths.size()) {
+      optional<Instance> instance;
+
+      try {
+        if (!pending.empty()) {
+          future<Instance> loading = std::move(pending.front());
+          pending.pop_front();
+          instance.emplace(loading.get());
+        } else {
+          next_start++;
+          instance.emplace(load(paths[next_idx]));
+        }
+      } catch (const exception& error) {
+        log_instance_error(paths[next_idx], error);
+      }
+
+      next_idx++;
+      start_prefetch();
+
+      if (instance) return instance;
+    }
+
+    return nullopt;
+  }
+
+  size_t size() const {
+    return paths.size();
+  }
+
+  int get_prefetch() const {
+    return prefetch;
+  }
+};
+
 class IntancesReader {
  private:
-  vector<struct Instance> instances;
+  vector<string> instance_paths;
 
   vector<string> get_instances_file_names(const string& instance_folder) {
     vector<string> instance_file_names;
 
     for (const auto& entry : fs::directory_iterator(instance_folder)) {
       if (entry.is_regular_file() && entry.path().extension() == ".txt") {
-        instance_file_names.push_back(entry.path().string());
+        // Usa a versão pré-compilada (Tools/convert_instances.cpp) quando ela existir; se o .txt mudou
+        // depois da conversão, Instance detecta o binário desatualizado e lê o texto
+        fs::path binary_path = entry.path();
+        binary_path.replace_extension(BINARY_INSTANCE_EXTENSION);
+
+        if (fs::exists(binary_path)) {
+          instance_file_names.push_back(binary_path.string());
+        } else {
+          instance_file_names.push_back(entry.path().string());
+        }
       }
     }
 
+    // directory_iterator não garante ordem; ordenar deixa os resultados iguais em qualquer máquina
+    sort(instance_file_names.begin(), instance_file_names.end());
+
     return instance_file_names;
   }
 
-  void read_instances(const vector<string>& instance_folder_names) {
-    for (const auto& name : instance_folder_names) {
-      const string folder_path = INSTANCES_DIR + name;
+  // As pastas são listadas em paralelo; a ordem final é a de instance_folder_names
+  void read_instance_paths(const vector<string>& instance_folder_names) {
+    vector<vector<string>> folder_paths(instance_folder_names.size());
+
+    ThreadPool pool(0);
+    pool.parallel_for(sz(instance_folder_names), [&](int idx, int) {
+      const string folder_path = INSTANCES_DIR + instance_folder_names[idx];
 
       if (!fs::exists(folder_path) || !fs::is_directory(folder_path)) {
-        cerr << "[faild]: path for instances invalid or is not a directory " << folder_path << endl;
-        continue;
+        fprintf(stderr, "[faild]: path for instances invalid or is not a directory %s\n", folder_path.c_str());
+        return;
       }
 
-      const vector<string> instance_file_names = get_instances_file_names(folder_path);
+      folder_paths[idx] = get_instances_file_names(folder_path);
+    });
 
-      for (const auto& instance_path : instance_file_names) {
-        Instance instance(instance_path);
-        instances.push_back(instance);
-      }
+    for (const vector<string>& paths : folder_paths) {
+      instance_paths.insert(instance_paths.end(), paths.begin(), paths.end());
     }
   }
 
  public:
+  // Apenas lista os arquivos; as instâncias são lidas sob demanda por stream()
   IntancesReader(vector<string> instance_folder_names = { "type1/", "type2/", "type3/", "type4/" }) {
-    read_instances(instance_folder_names);
+    read_instance_paths(instance_folder_names);
+  }
+
+  const vector<string>& get_instance_paths() const {
+    return instance_paths;
   }
 
-  const vector<Instance>& get_instances() const {
-    return instances;
+  // Leitura preguiçosa com até `prefetch` instâncias lidas em paralelo (ver InstanceStream)
+  InstanceStream stream(int prefetch = 1) const {
+    return InstanceStream(instance_paths, prefetch);
   }
-};
\ No newline at end of file
+};
+
+#endif  // INSTANCES_CPP
@@ -0,0 +1,114 @@
+#ifndef COLUMNAR_FORMAT_H
+#define COLUMNAR_FORMAT_H
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "./report.cpp"
+
+// Formato colunar dos resultados (result-N.kres), alternativa ao CSV para campanhas longas.
+// Todos os inteiros são little-endian.
+//
+//   cabeçalho (16 bytes): magic "KMISRES\0", uint32 version, uint32 reservado (0)
+//   blocos, até o fim do arquivo:
+//     uint32 num_rows
+//     uint32 num_new_names
+//     num_new_names x { uint32 length, length bytes }   nomes novos do dicionário de instâncias
+//     uint32  instance_id[num_rows]                     índice no dicionário (acumulado no arquivo)
+//     int32   k[num_rows]
+//     int32   best_ans[num_rows]
+//     int32   iteration[num_rows]                       -1 quando o solver não informa
+//     float32 duration_ms[num_rows]
+//
+// O dicionário começa vazio em cada arquivo e cada bloco só traz os nomes que ainda não
+// apareceram, então o nome da instância custa 4 bytes por linha.
+
+// As colunas são copiadas direto da memória: em um host big-endian (ou sem float IEEE 754) o
+// arquivo sairia ilegível, então a compilação falha em vez de gravar .kres errados. O MSVC só
+// gera código little-endian e não define __BYTE_ORDER__.
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "the .kres writer requires a little-endian host");
+#endif
+static_assert(std::numeric_limits<float>::is_iec559, "the .kres writer requires IEEE 754 floats");
+
+const char COLUMNAR_RESULT_MAGIC[8] = {'K', 'M', 'I', 'S', 'R', 'E', 'S', '\0'};
+const uint32_t COLUMNAR_RESULT_VERSION = 1;
+const std::string COLUMNAR_RESULT_EXTENSION = ".kres";
+
+class ColumnarResultChunk {
+ private:
+  std::unordered_map<std::string, uint32_t> dictionary;  // todos os nomes já escritos no arquivo
+  std::vector<std::string> new_names;
+
+  std::vector<uint32_t> instance_id;
+  std::vector<int32_t> k;
+  std::vector<int32_t> best_ans;
+  std::vector<int32_t> iteration;
+  std::vector<float> duration_ms;
+
+  template <typename T>
+  static void append_raw(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  static void append_column(std::string& out, const std::vector<T>& column) {
+    out.append(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(T));
+  }
+
+ public:
+  static void append_header(std::string& out) {
+    out.append(COLUMNAR_RESULT_MAGIC, sizeof(COLUMNAR_RESULT_MAGIC));
+    append_raw(out, COLUMNAR_RESULT_VERSION);
+    append_raw(out, uint32_t(0));
+  }
+
+  void append(const std::string& instance_name, int instance_k, const std::vector<ReportRow>& rows) {
+    auto [it, inserted] = dictionary.emplace(instance_name, (uint32_t)dictionary.size());
+    if (inserted) new_names.push_back(instance_name);
+
+    for (const ReportRow& row : rows) {
+      instance_id.push_back(it->second);
+      k.push_back(instance_k);
+      best_ans.push_back(row.best_ans);
+      iteration.push_back(row.iteration);
+      duration_ms.push_back(row.duration_ms);
+    }
+  }
+
+  size_t num_rows() const {
+    return instance_id.size();
+  }
+
+  // Escreve o bloco em out e esvazia as colunas (o dicionário é mantido)
+  void serialize(std::string& out) {
+    if (instance_id.empty() && new_names.empty()) return;
+
+    append_raw(out, (uint32_t)instance_id.size());
+    append_raw(out, (uint32_t)new_names.size());
+
+    for (const std::string& name : new_names) {
+      append_raw(out, (uint32_t)name.size());
+      out += name;
+    }
+
+    append_column(out, instance_id);
+    append_column(out, k);
+    append_column(out, best_ans);
+    append_column(out, iteration);
+    append_column(out, duration_ms);
+
+    new_names.clear();
+    instance_id.clear();
+    k.clear();
+    best_ans.clear();
+    iteration.clear();
+    duration_ms.clear();
+  }
+};
+
+#endif
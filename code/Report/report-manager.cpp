@@ -1,24 +1,76 @@
 #ifndef REPORT_MANAGER_H
 #define REPORT_MANAGER_H
 
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
+#include "../Utils/mpsc_queue.cpp"
 #include "../common.hpp"
 
+#include "./columnar-format.cpp"
 #include "./report.cpp"
 
 using namespace std;
 
 namespace fs = std::filesystem;
 
+// CSV: instance,k,best_ans,duration_ms (result-N.csv)
+// COLUMNAR: colunas binárias com dicionário de instâncias (result-N.kres, ver columnar-format.cpp)
+enum class ReportFormat { CSV, COLUMNAR };
+
+// Os relatórios são gravados por uma thread de fundo: add_reports só avalia as linhas e
+// as coloca em uma fila sem locks, então as threads dos solvers nunca esperam pelo disco.
+// O escritor junta as linhas em um buffer grande e faz uma escrita por rodada.
+//
+// Os valores gravados são os informados pelos solvers (ReportExecData::value). Com
+// verify_every > 0 o escritor também recalcula, pelos bitmaps, uma a cada verify_every
+// linhas (e a última de cada relatório) e avisa quando o valor não confere.
 class ReportManager {
  protected:
+  // Tamanho do buffer a partir do qual o escritor grava sem esperar esvaziar a fila
+  static constexpr size_t WRITE_BUFFER_BYTES = 1 << 20;
+
+  // Linhas por bloco no formato colunar antes de serializar sem esperar esvaziar a fila
+  static constexpr size_t COLUMNAR_CHUNK_ROWS = 1 << 16;
+
+  // Intervalo máximo que o escritor dorme sem ser acordado
+  static constexpr std::chrono::milliseconds WRITER_IDLE_WAIT{50};
+
+  struct ReportBatch {
+    string instance_name;
+    int k = 0;
+    vector<ReportRow> rows;
+    shared_ptr<const Report> report;  // só no modo de verificação
+  };
+
+  int verify_every = 0;
+  std::atomic<int> num_verification_failures{0};
+
+  ReportFormat format = ReportFormat::CSV;
+  ColumnarResultChunk columnar_chunk;  // usado só pela thread escritora
+
   string report_directory = "../Results";
   string report_file_name = "";
 
-  vector<Report> reports;
+  std::atomic<int> num_reports{0};
+
+  MpscQueue<ReportBatch> queue;
+
+  std::atomic<bool> pending{false};
+  std::atomic<bool> stop{false};
+  std::mutex wake_mtx;
+  std::condition_variable wake_cv;
+
+  std::thread writer;
 
   // count results file into directory ${report_directory}
   int get_results_size() const {
@@ -51,61 +103,182 @@ class ReportManager {
     }
   }
 
- public:
-  ReportManager(std::string algo) {
-    this->report_directory = "../Results/" + algo;
-    this->report_file_name = "result-" + std::to_string(this->get_results_size() + 1) + ".csv";
+  template <typename T>
+  static void append_number(string& buffer, T value) {
+    char digits[64];
+    auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, end);
   }
-  
-  ~ReportManager() = default;
-  
-  void add_reports(Report& new_report) {
-    this->reports.push_back(new_report);
-    
-    this->save_reports_on_file(new_report);
+
+  // instance,k,best_ans,duration_ms (duration com 6 casas, como o std::to_string usado antes)
+  static void format_batch(const ReportBatch& batch, string& buffer) {
+    for (const ReportRow& row : batch.rows) {
+      buffer += batch.instance_name;
+      buffer += ',';
+      append_number(buffer, batch.k);
+      buffer += ',';
+      append_number(buffer, row.best_ans);
+      buffer += ',';
+
+      char digits[64];
+      auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), row.duration_ms, std::chars_format::fixed, 6);
+      buffer.append(digits, end);
+
+      buffer += '\n';
+    }
   }
-  
-  void save_reports_on_file(Report& new_report) {
-    this->verify_or_create_path();
-    
-    cout << "[log]: init save reports..." << endl;
-    
-    std::ofstream report_file(this->get_fullpath(), std::ios_base::app | std::ios_base::out);
-    
-    if (!this->reports.size()) {
-      cout << "[faild]: Rerports is empty \n";
+
+  void verify_batch(const ReportBatch& batch) {
+    const vector<ReportExecData>& exec_data = batch.report->get_exec_data();
+
+    for (int i = 0; i < sz(exec_data); i++) {
+      if (i % verify_every != 0 && i != sz(exec_data) - 1) continue;
+
+      const int expected = batch.report->get_ans(exec_data[i].best_ans);
+
+      if (expected != exec_data[i].value) {
+        num_verification_failures.fetch_add(1, std::memory_order_relaxed);
+        cerr << "[faild]: report value mismatch in " << batch.instance_name << " row " << i
+             << ": recorded " << exec_data[i].value << ", recomputed " << expected << endl;
+      }
+    }
+  }
+
+  void add_batch(const ReportBatch& batch, string& buffer) {
+    if (format == ReportFormat::CSV) {
+      format_batch(batch, buffer);
       return;
     }
-    
-    try {
-      if (!report_file.is_open()) {
+
+    columnar_chunk.append(batch.instance_name, batch.k, batch.rows);
+
+    if (columnar_chunk.num_rows() >= COLUMNAR_CHUNK_ROWS) {
+      columnar_chunk.serialize(buffer);
+    }
+  }
+
+  bool flush_buffer(FILE*& file, string& buffer) {
+    if (buffer.empty()) return true;
+
+    if (!file) {
+      this->verify_or_create_path();
+      const bool empty_file = fs::file_size(this->get_fullpath()) == 0;
+
+      file = fopen(this->get_fullpath().c_str(), "ab");
+
+      if (!file) {
         cout << "[faild]: the file could not be opened.\n";
-        return;
+        return false;
       }
-      
-      for (auto instance : new_report.get_data()) {
-        int i = 0;
-        for (auto [key, value] : instance) {
-          if (i) {
-            report_file << "," + value;
-          } else {
-            report_file << value;
-          }
-          i++;
+
+      if (format == ReportFormat::COLUMNAR && empty_file) {
+        string header;
+        ColumnarResultChunk::append_header(header);
+        fwrite(header.data(), 1, header.size(), file);
+      }
+    }
+
+    const bool ok = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size() && fflush(file) == 0;
+    buffer.clear();
+
+    if (!ok) {
+      cout << "[failed]: Report is not saved\n";
+    }
+
+    return ok;
+  }
+
+  void writer_loop() {
+    FILE* file = nullptr;
+    string buffer;
+    buffer.reserve(WRITE_BUFFER_BYTES + 4096);
+
+    ReportBatch batch;
+
+    while (true) {
+      // Lido antes de esvaziar a fila: tudo que foi enfileirado antes do stop é gravado
+      const bool stopping = stop.load(std::memory_order_acquire);
+
+      while (queue.pop(batch)) {
+        if (batch.report) {
+          verify_batch(batch);
+          batch.report.reset();
+        }
+
+        add_batch(batch, buffer);
+
+        // Log feito só pela thread escritora, então as linhas não se misturam
+        cout << "[log]: report added: " << batch.instance_name << endl;
+
+        if (buffer.size() >= WRITE_BUFFER_BYTES) {
+          flush_buffer(file, buffer);
         }
-        report_file << endl;
       }
-      
-      report_file.close();
-      
-      cout << "[success] Reports saved\n";
-      
-    } catch (exception& e) {
-      cout << "[failed]: Report is not saved";
-      cerr << e.what() << endl;
-      return throw exception();
-    };
+
+      if (format == ReportFormat::COLUMNAR) columnar_chunk.serialize(buffer);
+      flush_buffer(file, buffer);
+
+      if (stopping) break;
+
+      std::unique_lock<std::mutex> lock(wake_mtx);
+      wake_cv.wait_for(lock, WRITER_IDLE_WAIT, [&] {
+        return stop.load(std::memory_order_acquire) || pending.exchange(false, std::memory_order_acq_rel);
+      });
+    }
+
+    if (file) fclose(file);
+  }
+
+ public:
+  ReportManager(std::string algo, int verify_every = 0, ReportFormat format = ReportFormat::CSV)
+      : verify_every(verify_every), format(format) {
+    const string extension = format == ReportFormat::COLUMNAR ? COLUMNAR_RESULT_EXTENSION : ".csv";
+
+    this->report_directory = "../Results/" + algo;
+    this->report_file_name = "result-" + std::to_string(this->get_results_size() + 1) + extension;
+
+    this->writer = std::thread(&ReportManager::writer_loop, this);
+  }
+
+  ReportManager(const ReportManager&) = delete;
+  ReportManager& operator=(const ReportManager&) = delete;
+
+  // Espera o escritor gravar tudo que ainda está na fila
+  ~ReportManager() {
+    {
+      std::lock_guard<std::mutex> lock(wake_mtx);
+      stop.store(true, std::memory_order_release);
+    }
+    wake_cv.notify_one();
+
+    writer.join();
+  }
+
+  // Pode ser chamado por várias threads ao mesmo tempo (BatchRunner)
+  void add_reports(Report new_report) {
+    ReportBatch batch;
+    batch.instance_name = new_report.get_instance_name();
+    batch.k = new_report.get_k();
+    batch.rows = new_report.get_rows();
+
+    if (verify_every > 0) {
+      batch.report = make_shared<const Report>(std::move(new_report));
+    }
+
+    queue.push(std::move(batch));
+    this->num_reports.fetch_add(1, std::memory_order_relaxed);
+
+    pending.store(true, std::memory_order_release);
+    wake_cv.notify_one();
+  }
+
+  int get_num_reports() const {
+    return this->num_reports.load(std::memory_order_relaxed);
+  }
+
+  int get_num_verification_failures() const {
+    return this->num_verification_failures.load(std::memory_order_relaxed);
   }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -2,26 +2,40 @@
 #define REPORT_H
 
 #include <iostream>
-#include <set>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "../Utils/solution_ids.cpp"
 #include "../bibliotecas/roaring.hh"
 
 typedef roaring::Roaring Subset;
 
+// Uma melhoria registrada pelo solver. value é o kMIS de best_ans, já conhecido pelo
+// solver no momento do registro; iteration é a iteração do solver (-1 se não houver).
+// best_ans guarda só os k índices da solução (usados na verificação), não o SolutionIds inteiro.
 struct ReportExecData {
-  std::set<int> best_ans;
+  std::vector<int> best_ans;
+  int value;
+  int iteration;
   float duration_ms;
 
-  ReportExecData(std::set<int> best_ans, float duration_ms) : best_ans(best_ans), duration_ms(duration_ms) {
+  ReportExecData(const SolutionIds& best_ans, int value, float duration_ms, int iteration = -1)
+      : best_ans(best_ans.begin(), best_ans.end()), value(value), iteration(iteration), duration_ms(duration_ms) {
   }
 };
 
+// Linha do relatório: é o que o ReportManager enfileira para o escritor
+struct ReportRow {
+  int best_ans;
+  int iteration;
+  float duration_ms;
+};
+
 struct Report {
  private:
-  std::vector<Subset> connections;
+  std::shared_ptr<const std::vector<Subset>> connections;  // da Instance; só para recalcular valores
   std::string instance_name;
   int k;
 
@@ -29,45 +43,55 @@ struct Report {
 
  public:
   Report(
-      std::vector<Subset> connections,
+      std::shared_ptr<const std::vector<Subset>> connections,
       std::string instance_name,
       int k,
-      std::vector<ReportExecData>& reports_data) : connections(connections),
-                                                   instance_name(instance_name),
-                                                   k(k),
-                                                   reports_data(reports_data) {
+      std::vector<ReportExecData> reports_data) : connections(std::move(connections)),
+                                                  instance_name(std::move(instance_name)),
+                                                  k(k),
+                                                  reports_data(std::move(reports_data)) {
   }
   
-  int get_ans(std::set<int>& ans_idx) {
+  // Recalcula o kMIS de uma solução intersectando os bitmaps (usado só na verificação)
+  int get_ans(const std::vector<int>& ans_idx) const {
     if (ans_idx.empty()) {
       return 0;
     }
 
     // Começar com o primeiro conjunto
     auto it = ans_idx.begin();
-    Subset intersection = this->connections[*it];
+    Subset intersection = (*this->connections)[*it];
     ++it;
 
     // Calcular a interseção com os demais conjuntos
     for (; it != ans_idx.end(); ++it) {
-      intersection = intersection & this->connections[*it];
+      intersection &= (*this->connections)[*it];
     }
 
     return intersection.cardinality();
   }
 
-  std::vector<std::vector<std::pair<std::string, std::string>>> get_data() {
-    std::vector<std::vector<std::pair<std::string, std::string>>> reports_data_map;
+  const std::string& get_instance_name() const {
+    return this->instance_name;
+  }
+
+  int get_k() const {
+    return this->k;
+  }
+
+  const std::vector<ReportExecData>& get_exec_data() const {
+    return this->reports_data;
+  }
+
+  std::vector<ReportRow> get_rows() const {
+    std::vector<ReportRow> rows;
+    rows.reserve(this->reports_data.size());
 
-    for (int i = 0; i < (int)this->reports_data.size(); ++i) {
-      reports_data_map.push_back({});
-      reports_data_map[i].push_back({"instance", this->instance_name});
-      reports_data_map[i].push_back({"k", std::to_string(this->k)});
-      reports_data_map[i].push_back({"best_ans", std::to_string(this->get_ans(this->reports_data[i].best_ans))});
-      reports_data_map[i].push_back({"duration_ms", std::to_string(this->reports_data[i].duration_ms)});
+    for (const ReportExecData& data : this->reports_data) {
+      rows.push_back({data.value, data.iteration, data.duration_ms});
     }
 
-    return reports_data_map;
+    return rows;
   }
 };
 
@@ -0,0 +1,171 @@
+// Teste de leitura de instâncias malformadas: Instance deve lançar InstanceError (nunca devolver
+// uma instância parcialmente lida) e o InstanceStream deve pular o arquivo e seguir para o próximo.
+// Também cobre o binário .kmis: cabeçalho/offsets corrompidos e binário desatualizado.
+//
+// Compilar e executar a partir de code/:
+//   g++ -std=c++17 -O2 -pthread -o test_malformed_instances Tests/malformed_instances.cpp bibliotecas/roaring.c
+//   ./test_malformed_instances               (código de saída != 0 em caso de falha)
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../Intances/instances.cpp"
+
+int failures = 0;
+
+void check(bool condition, const string& message) {
+  if (!condition) {
+    printf("[FAIL] %s\n", message.c_str());
+    failures++;
+  }
+}
+
+string write_file(const fs::path& dir, const string& name, const string& content) {
+  const fs::path path = dir / name;
+  ofstream(path) << content;
+  return path.string();
+}
+
+bool throws_instance_error(const string& path) {
+  try {
+    Instance instance(path);
+  } catch (const InstanceError&) {
+    return true;
+  }
+
+  return false;
+}
+
+// Reescreve size bytes do .kmis a partir de offset
+void patch_file(const string& path, size_t offset, const void* data, size_t size) {
+  fstream file(path, ios::binary | ios::in | ios::out);
+  file.seekp(offset);
+  file.write(static_cast<const char*>(data), size);
+}
+
+void check_binary_instances(const fs::path& dir) {
+  const string txt = write_file(dir, "binary.txt", "3 4 4 2\n1 1\n1 2\n2 2\n3 4\n");
+  const string kmis = (dir / "binary.kmis").string();
+
+  check(Instance(txt).save_binary(kmis), "save_binary succeeds");
+
+  {
+    Instance instance(kmis);
+    check(instance.get_connections()[0].cardinality() == 2 && instance.get_connections()[2].contains(3),
+          "binary instance round-trips");
+  }
+
+  // .txt alterado depois da conversão: o binário é ignorado e o texto é lido
+  write_file(dir, "binary.txt", "3 4 1 2\n3 1\n");
+  {
+    Instance instance(kmis);
+    check(instance.get_connections()[0].isEmpty() && instance.get_connections()[2].contains(0),
+          "stale binary falls back to the text file");
+  }
+
+  // Sem o .txt, um binário corrompido é um erro
+  const string intact = (dir / "intact.kmis").string();
+  check(Instance(txt).save_binary(kmis), "save_binary succeeds after the .txt changed");
+  fs::copy_file(kmis, intact, fs::copy_options::overwrite_existing);
+  fs::remove(txt);
+
+  const size_t entries_offset = sizeof(BinaryInstanceHeader);
+  const uint64_t huge_offset = ~uint64_t(0) - 8;
+  const uint64_t small_size = 16;
+  const int32_t big_k = 10;
+  const uint32_t bad_version = 1;
+
+  struct Corruption {
+    string name;
+    size_t offset;
+    const void* data;
+    size_t size;
+  };
+
+  const vector<Corruption> corruptions = {
+      {"offset + size overflow", entries_offset, &huge_offset, sizeof(huge_offset)},
+      {"size past end of file", entries_offset + sizeof(uint64_t), &huge_offset, sizeof(huge_offset)},
+      {"offset inside the header", entries_offset, &small_size, sizeof(small_size)},
+      {"k > L", offsetof(BinaryInstanceHeader, k), &big_k, sizeof(big_k)},
+      {"old version", offsetof(BinaryInstanceHeader, version), &bad_version, sizeof(bad_version)},
+  };
+
+  for (const Corruption& corruption : corruptions) {
+    fs::copy_file(intact, kmis, fs::copy_options::overwrite_existing);
+    patch_file(kmis, corruption.offset, corruption.data, corruption.size);
+    check(throws_instance_error(kmis), "binary with " + corruption.name + " should throw InstanceError");
+  }
+
+  fs::resize_file(intact, sizeof(BinaryInstanceHeader) + 8);
+  check(throws_instance_error(intact), "truncated binary should throw InstanceError");
+}
+
+int main() {
+  const fs::path dir = fs::temp_directory_path() / "kmis_malformed_instances";
+  fs::create_directories(dir);
+
+  const string valid = write_file(dir, "valid.txt", "3 2 3 2\n1 1\n2 1\n3 2\n");
+
+  const vector<pair<string, string>> malformed = {
+      {"empty.txt", ""},
+      {"short_header.txt", "3 2\n"},
+      {"garbage_header.txt", "3 x 3 2\n1 1\n"},
+      {"negative_sizes.txt", "-3 2 1 2\n1 1\n"},
+      {"k_too_large.txt", "3 2 1 4\n1 1\n"},
+      {"missing_edges.txt", "3 2 3 2\n1 1\n2 1\n"},
+      {"edge_left_out_of_bounds.txt", "3 2 2 2\n1 1\n4 1\n"},
+      {"edge_right_out_of_bounds.txt", "3 2 2 2\n1 1\n2 3\n"},
+      {"edge_zero.txt", "3 2 1 2\n0 1\n"},
+      {"l_over_capacity.txt", "70000 2 1 2\n1 1\n"},
+  };
+
+  vector<string> stream_paths;
+
+  for (const auto& [name, content] : malformed) {
+    const string path = write_file(dir, name, content);
+    check(throws_instance_error(path), name + " should throw InstanceError");
+    stream_paths.push_back(path);
+  }
+
+  check(throws_instance_error((dir / "does_not_exist.txt").string()), "missing file should throw InstanceError");
+
+  // Instância válida: lida normalmente
+  try {
+    Instance instance(valid);
+    check(instance.get_num_elements_l() == 3 && sz(instance.get_connections()) == 3, "valid instance has 3 bitmaps");
+    check(instance.get_connections()[0].contains(0) && instance.get_connections()[2].contains(1), "valid instance edges");
+  } catch (const exception& error) {
+    check(false, string("valid instance threw: ") + error.what());
+  }
+
+  // Os leitores pulam as malformadas: só a válida (no meio da lista) é entregue
+  stream_paths.insert(stream_paths.begin() + stream_paths.size() / 2, valid);
+
+  for (int prefetch : {0, 1, 4}) {
+    InstanceStream stream(stream_paths, prefetch);
+    int delivered = 0;
+
+    while (optional<Instance> instance = stream.next()) {
+      check(instance->get_file_name() == valid, "stream delivered only the valid instance");
+      delivered++;
+    }
+
+    check(delivered == 1, "stream delivered exactly one instance (prefetch=" + std::to_string(prefetch) + ")");
+  }
+
+  check_binary_instances(dir);
+
+  fs::remove_all(dir);
+
+  if (failures) {
+    printf("%d check(s) failed\n", failures);
+    return 1;
+  }
+
+  printf("[success]: malformed instances rejected\n");
+  return 0;
+}
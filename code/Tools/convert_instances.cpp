@@ -0,0 +1,65 @@
+// Converte as instâncias texto do Dataset para o formato binário .kmis (ver Intances/instance.model.cpp).
+// Cada classe_X.txt ganha um classe_X.kmis ao lado; o IntancesReader passa a carregar o binário.
+//
+// Compilar e executar a partir de code/:
+//   g++ -std=c++17 -O3 -o convert_instances Tools/convert_instances.cpp bibliotecas/roaring.c
+//   ./convert_instances                      (type1/ ... type4/)
+//   ./convert_instances Dataset/type1/classe_1_100_100.txt ...
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "../Intances/instances.cpp"
+
+// Falha (sem gravar nada) se o .txt não puder ser lido ou estiver malformado
+bool convert_instance(const string& txt_path) {
+  fs::path binary_path = txt_path;
+  binary_path.replace_extension(BINARY_INSTANCE_EXTENSION);
+
+  try {
+    Instance instance(txt_path);
+
+    if (!instance.save_binary(binary_path.string())) {
+      printf("[faild]: %s\n", txt_path.c_str());
+      return false;
+    }
+  } catch (const InstanceError& error) {
+    printf("[faild]: %s\n", error.what());
+    return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char** argv) {
+  vector<string> txt_paths;
+
+  if (argc > 1) {
+    for (int i = 1; i < argc; i++) txt_paths.push_back(argv[i]);
+  } else {
+    for (const string folder : {"type1/", "type2/", "type3/", "type4/"}) {
+      const string folder_path = INSTANCES_DIR + folder;
+      if (!fs::is_directory(folder_path)) continue;
+
+      for (const auto& entry : fs::directory_iterator(folder_path)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+          txt_paths.push_back(entry.path().string());
+        }
+      }
+    }
+  }
+
+  auto start_time = chrono::steady_clock::now();
+
+  int converted = 0;
+  for (const string& txt_path : txt_paths) {
+    converted += convert_instance(txt_path);
+  }
+
+  auto elapsed_ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start_time).count();
+
+  printf("[success]: %d/%d instances converted in %lld ms\n", converted, (int)txt_paths.size(), (long long)elapsed_ms);
+}
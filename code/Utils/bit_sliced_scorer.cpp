@@ -0,0 +1,182 @@
+#ifndef BIT_SLICED_SCORER_CPP
+#define BIT_SLICED_SCORER_CPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Pontuação de todos os candidatos de uma vez: dado um conjunto base B ⊆ R, calcula
+// score[j] = |B ∩ F[j]| para todo j ∈ L. É a pergunta feita pelo ACOKMIS (μ de cada candidato)
+// e pelo GRASPTs (função gulosa do CRG e valor das trocas da Busca Tabu).
+//
+// A instância é guardada transposta: rows[r] é a máscara dos j com r ∈ F[j]. Somar as linhas
+// r ∈ B dá score[j] em cada posição de bit; a soma é feita "na vertical" com contadores
+// fatiados em bits (planes[p] guarda o bit p dos contadores de 64 candidatos por palavra),
+// somando duas linhas por vez com um carry-save adder no estilo Harley–Seal. Cada bloco de
+// LANES palavras (256 candidatos) cabe em um registrador AVX2.
+class BitSlicedScorer {
+ public:
+  static constexpr int LANES = 4;        // palavras de 64 bits por bloco (um __m256i)
+  static constexpr int MAX_PLANES = 17;  // contadores até 2^17 - 1, bem acima de qualquer |R| do Dataset
+
+ private:
+#ifdef __AVX2__
+  using Vec = __m256i;
+
+  static Vec vec_zero() { return _mm256_setzero_si256(); }
+  static Vec vec_load(const uint64_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+  static void vec_store(uint64_t* p, Vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+  static Vec vec_and(Vec a, Vec b) { return _mm256_and_si256(a, b); }
+  static Vec vec_or(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+  static Vec vec_xor(Vec a, Vec b) { return _mm256_xor_si256(a, b); }
+  static bool vec_is_zero(Vec v) { return _mm256_testz_si256(v, v); }
+#else
+  struct Vec {
+    uint64_t w[LANES];
+  };
+
+  static Vec vec_zero() { return Vec{}; }
+  static Vec vec_load(const uint64_t* p) {
+    Vec v;
+    for (int l = 0; l < LANES; l++) v.w[l] = p[l];
+    return v;
+  }
+  static void vec_store(uint64_t* p, Vec v) {
+    for (int l = 0; l < LANES; l++) p[l] = v.w[l];
+  }
+  static Vec vec_and(Vec a, Vec b) {
+    for (int l = 0; l < LANES; l++) a.w[l] &= b.w[l];
+    return a;
+  }
+  static Vec vec_or(Vec a, Vec b) {
+    for (int l = 0; l < LANES; l++) a.w[l] |= b.w[l];
+    return a;
+  }
+  static Vec vec_xor(Vec a, Vec b) {
+    for (int l = 0; l < LANES; l++) a.w[l] ^= b.w[l];
+    return a;
+  }
+  static bool vec_is_zero(Vec v) {
+    return (v.w[0] | v.w[1] | v.w[2] | v.w[3]) == 0;
+  }
+#endif
+
+  int num_candidates = 0;  // |L|
+  int num_rows = 0;        // |R|
+  int num_blocks = 0;      // blocos de LANES palavras por linha
+
+  std::vector<uint64_t> rows;  // rows[(r * num_blocks + b) * LANES + l]
+
+  const uint64_t* row_block(uint32_t r, int b) const {
+    return rows.data() + ((size_t)r * num_blocks + b) * LANES;
+  }
+
+  // Soma carry (peso 2^p) nos contadores a partir do plano p
+  static void ripple(Vec* planes, int p, Vec carry) {
+    for (; !vec_is_zero(carry); p++) {
+      const Vec next = vec_and(planes[p], carry);
+      planes[p] = vec_xor(planes[p], carry);
+      carry = next;
+    }
+  }
+
+  // Chama emit(j, peso) para cada bit ligado nos planos: score[j] = soma dos pesos de j
+  template <typename Subset, typename Emit>
+  void for_each_weight(const Subset& base, Emit emit) const {
+    Vec planes[MAX_PLANES + 1];
+
+    for (int b = 0; b < num_blocks; b++) {
+      std::fill(planes, planes + MAX_PLANES + 1, vec_zero());
+
+      // Harley–Seal: duas linhas por vez em um CSA sobre o plano 0; o carry segue para os planos altos
+      bool has_pending = false;
+      Vec pending = vec_zero();
+
+      for (uint32_t r : base) {
+        if (r >= (uint32_t)num_rows) continue;
+
+        const Vec row = vec_load(row_block(r, b));
+
+        if (!has_pending) {
+          pending = row;
+          has_pending = true;
+          continue;
+        }
+
+        const Vec u = vec_xor(planes[0], pending);
+        const Vec carry = vec_or(vec_and(planes[0], pending), vec_and(u, row));
+        planes[0] = vec_xor(u, row);
+        ripple(planes, 1, carry);
+
+        has_pending = false;
+      }
+
+      if (has_pending) ripple(planes, 0, pending);
+
+      uint64_t words[LANES];
+
+      for (int p = 0; p <= MAX_PLANES; p++) {
+        if (vec_is_zero(planes[p])) continue;
+
+        vec_store(words, planes[p]);
+
+        for (int l = 0; l < LANES; l++) {
+          const int first_j = (b * LANES + l) * 64;
+
+          for (uint64_t w = words[l]; w; w &= w - 1) {
+            emit(first_j + __builtin_ctzll(w), 1 << p);
+          }
+        }
+      }
+    }
+  }
+
+ public:
+  BitSlicedScorer() {}
+
+  // F[j] ⊆ [0, |R|); aceita roaring::Roaring ou DenseSubset
+  template <typename Subset>
+  BitSlicedScorer(const std::vector<Subset>& F) : num_candidates((int)F.size()) {
+    for (const Subset& f : F) {
+      for (uint32_t r : f) num_rows = std::max(num_rows, (int)r + 1);
+    }
+
+    assert(num_rows < (1 << MAX_PLANES) && "|R| grande demais para os contadores fatiados");
+
+    num_blocks = (num_candidates + 64 * LANES - 1) / (64 * LANES);
+    rows.assign((size_t)num_rows * num_blocks * LANES, 0);
+
+    for (int j = 0; j < num_candidates; j++) {
+      const int b = j / (64 * LANES);
+      const int l = j / 64 % LANES;
+
+      for (uint32_t r : F[j]) {
+        rows[((size_t)r * num_blocks + b) * LANES + l] |= uint64_t(1) << (j % 64);
+      }
+    }
+  }
+
+  int size() const {
+    return num_candidates;
+  }
+
+  // scores[j] = |base ∩ F[j]| para todo j (scores precisa ter size() posições)
+  template <typename Subset>
+  void score_all(const Subset& base, int* scores) const {
+    std::fill(scores, scores + num_candidates, 0);
+    for_each_weight(base, [&](int j, int weight) { scores[j] += weight; });
+  }
+
+  // scores[j] -= |base ∩ F[j]|, para manter pontuações incrementais quando base sai da interseção
+  template <typename Subset>
+  void subtract_scores(const Subset& base, int* scores) const {
+    for_each_weight(base, [&](int j, int weight) { scores[j] -= weight; });
+  }
+};
+
+#endif  // BIT_SLICED_SCORER_CPP
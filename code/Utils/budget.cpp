@@ -0,0 +1,145 @@
+#ifndef BUDGET_CPP
+#define BUDGET_CPP
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+// Relógio usado pelo limite de tempo e pelos tempos gravados nos relatórios:
+//   WALL        tempo de parede (steady_clock)
+//   THREAD_CPU  tempo de CPU da thread que executa o solver, então execuções em paralelo
+//               não são penalizadas por disputar núcleos com outras
+enum class BudgetClock { WALL, THREAD_CPU };
+
+// Critérios de parada de uma execução; a execução para no primeiro que for atingido.
+// time_limit_ms <= 0, max_evaluations == 0 e target_value < 0 desativam o critério.
+struct BudgetSpec {
+  BudgetClock clock = BudgetClock::WALL;
+  double time_limit_ms = 40000;  // limite usado no TCC (40 segundos)
+  uint64_t max_evaluations = 0;  // avaliações da função objetivo (ver count_evaluations)
+  int target_value = -1;         // para assim que uma solução com valor >= target_value é encontrada
+};
+
+// Orçamento de uma execução. O relógio é lido de forma amortizada: exhausted() só consulta o
+// relógio a cada check_stride chamadas, e o passo se ajusta para que as leituras fiquem perto de
+// CLOCK_CHECK_INTERVAL_MS, seja a chamada feita por iteração GRASP ou por iteração da Busca Tabu.
+// Com THREAD_CPU o objeto deve ser usado pela mesma thread que o criou.
+class Budget {
+ public:
+  static constexpr double CLOCK_CHECK_INTERVAL_MS = 1.0;
+  static constexpr uint32_t MAX_CHECK_STRIDE = 4096;
+
+ private:
+  BudgetSpec spec;
+
+  std::chrono::steady_clock::time_point wall_start;
+  double cpu_start_ms = 0;
+
+  uint64_t evaluations = 0;
+  bool target_reached = false;
+  bool time_over = false;
+
+  uint32_t check_stride = 1;
+  uint32_t calls_until_check = 0;
+  double last_check_ms = 0;
+
+  static double thread_cpu_ms() {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+#elif defined(_WIN32)
+    FILETIME creation, exit, kernel, user;
+    GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user);
+    const uint64_t kernel_100ns = (uint64_t(kernel.dwHighDateTime) << 32) | kernel.dwLowDateTime;
+    const uint64_t user_100ns = (uint64_t(user.dwHighDateTime) << 32) | user.dwLowDateTime;
+    return (kernel_100ns + user_100ns) / 1e4;
+#else
+    return 1e3 * std::clock() / CLOCKS_PER_SEC;  // sem relógio por thread: CPU do processo
+#endif
+  }
+
+ public:
+  explicit Budget(const BudgetSpec& spec = BudgetSpec()) : spec(spec) {
+    restart();
+  }
+
+  void restart() {
+    wall_start = std::chrono::steady_clock::now();
+    cpu_start_ms = spec.clock == BudgetClock::THREAD_CPU ? thread_cpu_ms() : 0;
+
+    evaluations = 0;
+    target_reached = false;
+    time_over = false;
+
+    check_stride = 1;
+    calls_until_check = 0;
+    last_check_ms = 0;
+  }
+
+  // Tempo desde restart() no relógio do orçamento (sempre lê o relógio)
+  double elapsed_ms() const {
+    if (spec.clock == BudgetClock::THREAD_CPU) return thread_cpu_ms() - cpu_start_ms;
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wall_start).count();
+  }
+
+  void count_evaluations(uint64_t n = 1) {
+    evaluations += n;
+  }
+
+  // Informa o valor de uma solução encontrada (para o critério target_value)
+  void report_value(int value) {
+    if (spec.target_value >= 0 && value >= spec.target_value) target_reached = true;
+  }
+
+  bool exhausted() {
+    if (target_reached) return true;
+    if (spec.max_evaluations > 0 && evaluations >= spec.max_evaluations) return true;
+    if (spec.time_limit_ms <= 0) return false;
+    if (time_over) return true;
+
+    if (calls_until_check > 0) {
+      calls_until_check--;
+      return false;
+    }
+
+    const double now = elapsed_ms();
+
+    if (now >= spec.time_limit_ms) {
+      time_over = true;
+      return true;
+    }
+
+    // Chamadas rápidas: lê o relógio com menos frequência; lentas: com mais
+    const double since_last_check = now - last_check_ms;
+    last_check_ms = now;
+
+    if (since_last_check < CLOCK_CHECK_INTERVAL_MS / 2 && check_stride < MAX_CHECK_STRIDE) {
+      check_stride *= 2;
+    } else if (since_last_check > CLOCK_CHECK_INTERVAL_MS && check_stride > 1) {
+      check_stride /= 2;
+    }
+
+    calls_until_check = check_stride - 1;
+
+    return false;
+  }
+
+  uint64_t get_evaluations() const {
+    return evaluations;
+  }
+
+  const BudgetSpec& get_spec() const {
+    return spec;
+  }
+};
+
+#endif  // BUDGET_CPP
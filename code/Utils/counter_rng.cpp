@@ -0,0 +1,143 @@
+#ifndef COUNTER_RNG_CPP
+#define COUNTER_RNG_CPP
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+// Gerador baseado em contador (Philox4x32-10, Salmon et al., SC'11): cada bloco de 4 números é
+// uma função pura de (chave, contador), sem estado compartilhado. A chave identifica a execução
+// (semente da campanha, instância, repetição) e o contador a posição dentro dela (fluxo,
+// iteração, bloco), então a sequência de uma iteração GRASP não depende de quantas threads
+// existem nem da ordem em que os jobs rodam. (O ACOKMIS é guloso e não usa números aleatórios.)
+
+// Identifica uma execução: semente da campanha, instância (hash do nome) e repetição
+struct RngKey {
+  uint64_t seed;
+  uint32_t instance;
+  uint32_t repetition;
+
+  RngKey(uint64_t seed = 0, uint32_t instance = 0, uint32_t repetition = 0)
+      : seed(seed), instance(instance), repetition(repetition) {}
+
+  // FNV-1a 32 bits: o id da instância vem do nome do arquivo, não da ordem de leitura
+  static uint32_t hash_name(const std::string& name) {
+    uint32_t h = 2166136261u;
+
+    for (unsigned char c : name) {
+      h ^= c;
+      h *= 16777619u;
+    }
+
+    return h;
+  }
+};
+
+class CounterRng {
+ public:
+  using result_type = uint32_t;
+
+ private:
+  static constexpr uint32_t PHILOX_M0 = 0xD2511F53;
+  static constexpr uint32_t PHILOX_M1 = 0xCD9E8D57;
+  static constexpr uint32_t PHILOX_W0 = 0x9E3779B9;
+  static constexpr uint32_t PHILOX_W1 = 0xBB67AE85;
+  static constexpr int PHILOX_ROUNDS = 10;
+
+  uint32_t key[2] = {0, 0};
+  uint32_t counter[4] = {0, 0, 0, 0};  // {bloco, iteração, fluxo, repetição}
+  uint32_t block[4] = {0, 0, 0, 0};
+  int next_word = 4;  // 4: bloco atual esgotado
+
+  static uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+  }
+
+  void generate_block() {
+    uint32_t c[4] = {counter[0], counter[1], counter[2], counter[3]};
+    uint32_t k0 = key[0];
+    uint32_t k1 = key[1];
+
+    for (int round = 0; round < PHILOX_ROUNDS; round++) {
+      const uint64_t p0 = (uint64_t)PHILOX_M0 * c[0];
+      const uint64_t p1 = (uint64_t)PHILOX_M1 * c[2];
+
+      const uint32_t next[4] = {(uint32_t)(p1 >> 32) ^ c[1] ^ k0, (uint32_t)p1,
+                                (uint32_t)(p0 >> 32) ^ c[3] ^ k1, (uint32_t)p0};
+
+      for (int w = 0; w < 4; w++) c[w] = next[w];
+
+      k0 += PHILOX_W0;
+      k1 += PHILOX_W1;
+    }
+
+    for (int w = 0; w < 4; w++) block[w] = c[w];
+
+    counter[0]++;
+    next_word = 0;
+  }
+
+ public:
+  CounterRng(const RngKey& rng_key = RngKey(), uint32_t stream = 0, uint32_t iteration = 0) {
+    set_key(rng_key);
+    set_position(stream, iteration);
+  }
+
+  void set_key(const RngKey& rng_key) {
+    const uint64_t k = splitmix64(rng_key.seed ^ splitmix64(rng_key.instance));
+
+    key[0] = (uint32_t)k;
+    key[1] = (uint32_t)(k >> 32);
+    counter[3] = rng_key.repetition;
+    next_word = 4;
+  }
+
+  // Vai para o início da sequência (fluxo, iteração): ex. (0, iteração GRASP)
+  void set_position(uint32_t stream, uint32_t iteration) {
+    counter[0] = 0;
+    counter[1] = iteration;
+    counter[2] = stream;
+    next_word = 4;
+  }
+
+  static constexpr result_type min() {
+    return 0;
+  }
+
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() {
+    if (next_word == 4) generate_block();
+    return block[next_word++];
+  }
+
+  // Uniforme em [0, 1) com 24 bits, igual em qualquer biblioteca padrão
+  // (as distribuições da std não têm resultado especificado)
+  float uniform_float() {
+    return ((*this)() >> 8) * (1.0f / 16777216.0f);
+  }
+
+  // Uniforme em [0, n), sem viés (multiplicação de Lemire com rejeição)
+  uint32_t uniform_int(uint32_t n) {
+    uint64_t m = (uint64_t)(*this)() * n;
+    uint32_t low = (uint32_t)m;
+
+    if (low < n) {
+      const uint32_t threshold = (0u - n) % n;
+
+      while (low < threshold) {
+        m = (uint64_t)(*this)() * n;
+        low = (uint32_t)m;
+      }
+    }
+
+    return (uint32_t)(m >> 32);
+  }
+};
+
+#endif  // COUNTER_RNG_CPP
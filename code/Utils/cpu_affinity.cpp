@@ -0,0 +1,130 @@
+#ifndef CPU_AFFINITY_CPP
+#define CPU_AFFINITY_CPP
+
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#elif _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+// Núcleos em que o processo pode rodar (respeita taskset/cgroups no Linux). No Windows são
+// numerados em sequência por todos os grupos de processadores. Vazio se não for suportado.
+inline std::vector<int> allowed_cpus() {
+  std::vector<int> cpus;
+
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+
+  if (sched_getaffinity(0, sizeof(cpu_set_t), &cpu_set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &cpu_set)) cpus.push_back(cpu);
+    }
+  }
+#elif _WIN32
+  const int total = (int)GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+  for (int cpu = 0; cpu < total; cpu++) cpus.push_back(cpu);
+#endif
+
+  return cpus;
+}
+
+#ifdef _WIN32
+// Cada grupo tem no máximo 64 processadores: o índice global vira (grupo, bit)
+inline bool cpu_group_bit(int cpu, WORD& group, int& bit) {
+  const WORD num_groups = GetActiveProcessorGroupCount();
+
+  for (group = 0; group < num_groups; group++) {
+    const int group_size = (int)GetActiveProcessorCount(group);
+
+    if (cpu < group_size) {
+      bit = cpu;
+      return true;
+    }
+
+    cpu -= group_size;
+  }
+
+  return false;
+}
+#endif
+
+// Restringe a thread atual a um conjunto de núcleos (valores de allowed_cpus()). Threads criadas
+// depois herdam esse conjunto no Linux. No Windows a afinidade de uma thread cabe em um único
+// grupo: ficam só os núcleos do grupo do primeiro. Devolve false se não for suportado ou falhar.
+inline bool pin_current_thread_to_cpus(const std::vector<int>& cpus) {
+  if (cpus.empty()) return false;
+
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+
+  for (int cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    CPU_SET(cpu, &cpu_set);
+  }
+
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) == 0;
+#elif _WIN32
+  GROUP_AFFINITY affinity = {};
+  WORD first_group = 0;
+
+  for (int cpu : cpus) {
+    WORD group;
+    int bit;
+    if (cpu < 0 || !cpu_group_bit(cpu, group, bit)) return false;
+
+    if (affinity.Mask == 0) first_group = group;
+    if (group == first_group) affinity.Mask |= KAFFINITY(1) << bit;
+  }
+
+  affinity.Group = first_group;
+  return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0;
+#else
+  return false;
+#endif
+}
+
+// Núcleos em que a thread atual pode rodar, na numeração de allowed_cpus(). Serve para guardar
+// a afinidade antes de fixar a thread e restaurá-la com pin_current_thread_to_cpus.
+inline std::vector<int> current_thread_cpus() {
+  std::vector<int> cpus;
+
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+
+  if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &cpu_set)) cpus.push_back(cpu);
+    }
+  }
+#elif _WIN32
+  GROUP_AFFINITY affinity = {};
+
+  if (GetThreadGroupAffinity(GetCurrentThread(), &affinity)) {
+    int first = 0;
+    for (WORD group = 0; group < affinity.Group; group++) first += (int)GetActiveProcessorCount(group);
+
+    for (int bit = 0; bit < 64; bit++) {
+      if ((affinity.Mask >> bit) & 1) cpus.push_back(first + bit);
+    }
+  }
+#endif
+
+  return cpus;
+}
+
+// Fixa a thread atual em um núcleo (um dos valores de allowed_cpus()), para que execuções
+// com limite de tempo não disputem CPU entre si. Devolve false se não for suportado ou falhar.
+inline bool pin_current_thread_to_cpu(int cpu) {
+  return pin_current_thread_to_cpus({cpu});
+}
+
+#endif  // CPU_AFFINITY_CPP
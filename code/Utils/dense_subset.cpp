@@ -0,0 +1,203 @@
+#ifndef DENSE_SUBSET_CPP
+#define DENSE_SUBSET_CPP
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "../bibliotecas/roaring.hh"
+
+// Bitset denso com tamanho fixo em tempo de compilação: WORDS palavras de 64 bits, ou seja,
+// elementos do lado direito em [0, 64 * WORDS). Tem a parte da interface do roaring::Roaring
+// usada pelos solvers (&=, &, -, cardinality, and_cardinality, iteração), então ACOKMIS e
+// GRASPTs podem ser instanciados com qualquer um dos dois. Com WORDS pequeno os laços abaixo
+// são desenrolados pelo compilador e cada operação vira poucas instruções, sem alocação.
+template <int WORDS>
+class DenseSubset {
+  static_assert(WORDS > 0, "DenseSubset precisa de pelo menos uma palavra");
+
+ private:
+  std::array<uint64_t, WORDS> words{};
+
+ public:
+  static constexpr uint32_t CAPACITY = 64 * WORDS;
+
+  // Percorre os elementos em ordem crescente, como o iterador do Roaring
+  class const_iterator {
+   private:
+    const uint64_t* words = nullptr;
+    int word_idx = WORDS;
+    uint64_t current = 0;
+
+    void skip_empty_words() {
+      while (current == 0 && ++word_idx < WORDS) current = words[word_idx];
+    }
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = uint32_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const uint32_t*;
+    using reference = uint32_t;
+
+    const_iterator() = default;
+
+    const_iterator(const uint64_t* words, int word_idx) : words(words), word_idx(word_idx) {
+      if (word_idx < WORDS) {
+        current = words[word_idx];
+        skip_empty_words();
+      }
+    }
+
+    uint32_t operator*() const {
+      return word_idx * 64 + __builtin_ctzll(current);
+    }
+
+    const_iterator& operator++() {
+      current &= current - 1;
+      skip_empty_words();
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      return word_idx == other.word_idx && current == other.current;
+    }
+
+    bool operator!=(const const_iterator& other) const {
+      return !(*this == other);
+    }
+  };
+
+  DenseSubset() = default;
+
+  static DenseSubset from_roaring(const roaring::Roaring& bitmap) {
+    DenseSubset subset;
+
+    for (uint32_t x : bitmap) {
+      assert(x < CAPACITY && "elemento fora da capacidade do DenseSubset");
+      subset.add(x);
+    }
+
+    return subset;
+  }
+
+  void add(uint32_t x) {
+    words[x >> 6] |= uint64_t(1) << (x & 63);
+  }
+
+  void addMany(size_t n, const uint32_t* xs) {
+    for (size_t i = 0; i < n; i++) add(xs[i]);
+  }
+
+  bool contains(uint32_t x) const {
+    return x < CAPACITY && (words[x >> 6] >> (x & 63) & 1);
+  }
+
+  bool isEmpty() const {
+    for (int w = 0; w < WORDS; w++)
+      if (words[w]) return false;
+    return true;
+  }
+
+  uint64_t cardinality() const {
+    uint64_t count = 0;
+    for (int w = 0; w < WORDS; w++) count += __builtin_popcountll(words[w]);
+    return count;
+  }
+
+  // |this ∩ other| sem materializar a interseção
+  uint64_t and_cardinality(const DenseSubset& other) const {
+    uint64_t count = 0;
+    for (int w = 0; w < WORDS; w++) count += __builtin_popcountll(words[w] & other.words[w]);
+    return count;
+  }
+
+  DenseSubset& operator&=(const DenseSubset& other) {
+    for (int w = 0; w < WORDS; w++) words[w] &= other.words[w];
+    return *this;
+  }
+
+  DenseSubset& operator-=(const DenseSubset& other) {
+    for (int w = 0; w < WORDS; w++) words[w] &= ~other.words[w];
+    return *this;
+  }
+
+  DenseSubset operator&(const DenseSubset& other) const {
+    DenseSubset result = *this;
+    result &= other;
+    return result;
+  }
+
+  DenseSubset operator-(const DenseSubset& other) const {
+    DenseSubset result = *this;
+    result -= other;
+    return result;
+  }
+
+  bool operator==(const DenseSubset& other) const {
+    return words == other.words;
+  }
+
+  bool operator!=(const DenseSubset& other) const {
+    return words != other.words;
+  }
+
+  const uint64_t* data() const {
+    return words.data();
+  }
+
+  const_iterator begin() const {
+    return const_iterator(words.data(), 0);
+  }
+
+  const_iterator end() const {
+    return const_iterator(words.data(), WORDS);
+  }
+};
+
+// Conversão das conexões de uma instância para o backend escolhido
+template <typename Subset>
+std::vector<Subset> to_dense_subsets(const std::vector<roaring::Roaring>& connections) {
+  std::vector<Subset> subsets;
+  subsets.reserve(connections.size());
+
+  for (const roaring::Roaring& bitmap : connections) {
+    subsets.push_back(Subset::from_roaring(bitmap));
+  }
+
+  return subsets;
+}
+
+// Backend dos conjuntos usado pelos solvers:
+//   ROARING  sempre roaring::Roaring
+//   AUTO     o menor DenseSubset que comporta |R| (até 1024 elementos), senão Roaring
+enum class SubsetBackend { ROARING, AUTO };
+
+template <typename Subset>
+struct SubsetTag {
+  using type = Subset;
+};
+
+// Chama fn(SubsetTag<S>{}) com o tipo S escolhido para uma instância com num_elements_r
+// elementos do lado direito; cada S gera uma instanciação própria dos solvers.
+template <typename Fn>
+decltype(auto) with_subset_backend(SubsetBackend backend, int num_elements_r, Fn&& fn) {
+  if (backend == SubsetBackend::AUTO) {
+    if (num_elements_r <= 128) return fn(SubsetTag<DenseSubset<2>>{});
+    if (num_elements_r <= 256) return fn(SubsetTag<DenseSubset<4>>{});
+    if (num_elements_r <= 512) return fn(SubsetTag<DenseSubset<8>>{});
+    if (num_elements_r <= 1024) return fn(SubsetTag<DenseSubset<16>>{});
+  }
+
+  return fn(SubsetTag<roaring::Roaring>{});
+}
+
+#endif  // DENSE_SUBSET_CPP
@@ -0,0 +1,80 @@
+#ifndef MAPPED_FILE_CPP
+#define MAPPED_FILE_CPP
+
+#include <cstddef>
+#include <fstream>
+#include <new>
+#include <string>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_USE_MMAP
+#endif
+
+// Arquivo somente leitura mapeado em memória (mmap). Em sistemas sem mmap o arquivo é
+// lido inteiro para um buffer alinhado, com a mesma interface.
+class MappedFile {
+ private:
+  static constexpr std::size_t BUFFER_ALIGNMENT = 64;
+
+  const char* data_ = nullptr;
+  std::size_t size_ = 0;
+
+ public:
+  MappedFile(const std::string& path) {
+#ifdef MAPPED_FILE_USE_MMAP
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+      void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+      if (mapped != MAP_FAILED) {
+        data_ = static_cast<const char*>(mapped);
+        size_ = st.st_size;
+      }
+    }
+
+    close(fd);
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return;
+
+    std::size_t size = (std::size_t)file.tellg();
+    char* buffer = static_cast<char*>(::operator new(size, std::align_val_t(BUFFER_ALIGNMENT)));
+
+    file.seekg(0);
+    if (file.read(buffer, size)) {
+      data_ = buffer;
+      size_ = size;
+    } else {
+      ::operator delete(buffer, std::align_val_t(BUFFER_ALIGNMENT));
+    }
+#endif
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile() {
+    if (!data_) return;
+
+#ifdef MAPPED_FILE_USE_MMAP
+    munmap(const_cast<char*>(data_), size_);
+#else
+    ::operator delete(const_cast<char*>(data_), std::align_val_t(BUFFER_ALIGNMENT));
+#endif
+  }
+
+  bool is_open() const { return data_ != nullptr; }
+
+  const char* data() const { return data_; }
+
+  std::size_t size() const { return size_; }
+};
+
+#endif  // MAPPED_FILE_CPP
@@ -0,0 +1,60 @@
+#ifndef MPSC_QUEUE_CPP
+#define MPSC_QUEUE_CPP
+
+#include <atomic>
+#include <utility>
+
+// Fila sem locks com vários produtores e um único consumidor (lista encadeada de Vyukov).
+// push nunca bloqueia (uma troca atômica); pop só pode ser chamado pela thread consumidora.
+// O nó de cabeça é sempre um "stub" já consumido, por isso T precisa de construtor padrão.
+template <typename T>
+class MpscQueue {
+ private:
+  struct Node {
+    std::atomic<Node*> next{nullptr};
+    T value;
+  };
+
+  std::atomic<Node*> head;  // último nó inserido (produtores)
+  Node* tail;               // nó já consumido (consumidor)
+
+ public:
+  MpscQueue() {
+    Node* stub = new Node();
+    head.store(stub, std::memory_order_relaxed);
+    tail = stub;
+  }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  ~MpscQueue() {
+    while (tail) {
+      Node* next = tail->next.load(std::memory_order_relaxed);
+      delete tail;
+      tail = next;
+    }
+  }
+
+  void push(T value) {
+    Node* node = new Node();
+    node->value = std::move(value);
+
+    Node* prev = head.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  // false se a fila está vazia (ou se um push ainda não terminou de ligar o nó)
+  bool pop(T& out) {
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (!next) return false;
+
+    out = std::move(next->value);
+    delete tail;
+    tail = next;
+
+    return true;
+  }
+};
+
+#endif  // MPSC_QUEUE_CPP
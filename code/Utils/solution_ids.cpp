@@ -0,0 +1,178 @@
+#ifndef SOLUTION_IDS_CPP
+#define SOLUTION_IDS_CPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Maior |L| suportado: os índices são guardados em uint16_t. Instâncias maiores são rejeitadas
+// na leitura (InstanceError), e insert() lança std::length_error se receber um índice fora disso.
+constexpr int MAX_SOLUTION_ELEMENTS = 65536;
+
+// Capacidade interna (sem alocação): bitset para |L| <= 512 e até 256 índices na solução.
+// O Dataset tem |L| <= 300 e k <= 266, então só as soluções com k > 256 usam o heap.
+constexpr int SOLUTION_IDS_INLINE_ELEMENTS = 512;
+constexpr int SOLUTION_IDS_INLINE_IDS = 256;
+
+// Conjunto de índices de uma solução (ACO e GRASPTs):
+// - bitset denso para pertinência em O(1);
+// - vetor ordenado com os índices, percorrido na mesma ordem de um std::set<int>.
+// Bitset e vetor ficam dentro do objeto enquanto cabem na capacidade interna e passam para o
+// heap quando a ultrapassam, então copiar uma solução normalmente é só copiar os blocos usados.
+class SolutionIds {
+ private:
+  static constexpr int INLINE_WORDS = SOLUTION_IDS_INLINE_ELEMENTS / 64;
+
+  std::array<uint64_t, INLINE_WORDS> inline_membership{};
+  std::array<uint16_t, SOLUTION_IDS_INLINE_IDS> inline_ids;
+
+  // Vazios enquanto a capacidade interna é suficiente
+  std::vector<uint64_t> heap_membership;
+  std::vector<uint16_t> heap_ids;
+
+  int num_words = INLINE_WORDS;
+  int ids_capacity = SOLUTION_IDS_INLINE_IDS;
+  int count = 0;
+
+  uint64_t* words() {
+    return heap_membership.empty() ? inline_membership.data() : heap_membership.data();
+  }
+
+  const uint64_t* words() const {
+    return heap_membership.empty() ? inline_membership.data() : heap_membership.data();
+  }
+
+  uint16_t* ids() {
+    return heap_ids.empty() ? inline_ids.data() : heap_ids.data();
+  }
+
+  const uint16_t* ids() const {
+    return heap_ids.empty() ? inline_ids.data() : heap_ids.data();
+  }
+
+  void grow_membership(int e) {
+    std::vector<uint64_t> grown(std::max(2 * num_words, (e >> 6) + 1), 0);
+    std::copy(words(), words() + num_words, grown.begin());
+
+    heap_membership = std::move(grown);
+    num_words = (int)heap_membership.size();
+  }
+
+  void grow_ids() {
+    std::vector<uint16_t> grown(2 * ids_capacity);
+    std::copy(ids(), ids() + count, grown.begin());
+
+    heap_ids = std::move(grown);
+    ids_capacity = (int)heap_ids.size();
+  }
+
+  void copy_from(const SolutionIds& other) {
+    if (other.heap_membership.empty()) {
+      heap_membership.clear();
+      inline_membership = other.inline_membership;
+    } else {
+      heap_membership = other.heap_membership;
+    }
+
+    if (other.heap_ids.empty()) {
+      heap_ids.clear();
+    } else {
+      heap_ids.resize(other.heap_ids.size());
+    }
+
+    num_words = other.num_words;
+    ids_capacity = other.ids_capacity;
+    count = other.count;
+    std::memcpy(ids(), other.ids(), count * sizeof(uint16_t));
+  }
+
+ public:
+  using const_iterator = const uint16_t*;
+
+  SolutionIds() = default;
+
+  SolutionIds(const SolutionIds& other) {
+    copy_from(other);
+  }
+
+  SolutionIds& operator=(const SolutionIds& other) {
+    if (this != &other) copy_from(other);
+    return *this;
+  }
+
+  bool contains(int e) const {
+    if (e < 0 || (e >> 6) >= num_words) return false;
+
+    return (words()[e >> 6] >> (e & 63)) & 1;
+  }
+
+  // Insere mantendo os índices ordenados; ignora elementos repetidos
+  void insert(int e) {
+    if (e < 0 || e >= MAX_SOLUTION_ELEMENTS) {
+      throw std::length_error("element " + std::to_string(e) + " out of SolutionIds capacity (" +
+                              std::to_string(MAX_SOLUTION_ELEMENTS) + ")");
+    }
+
+    if (contains(e)) return;
+
+    if ((e >> 6) >= num_words) grow_membership(e);
+    if (count == ids_capacity) grow_ids();
+
+    words()[e >> 6] |= uint64_t(1) << (e & 63);
+
+    uint16_t* data = ids();
+    int pos = count;
+    while (pos > 0 && data[pos - 1] > e) {
+      data[pos] = data[pos - 1];
+      pos--;
+    }
+    data[pos] = (uint16_t)e;
+    count++;
+  }
+
+  void erase(int e) {
+    if (!contains(e)) return;
+
+    words()[e >> 6] &= ~(uint64_t(1) << (e & 63));
+
+    uint16_t* data = ids();
+    uint16_t* it = std::lower_bound(data, data + count, (uint16_t)e);
+    std::copy(it + 1, data + count, it);
+    count--;
+  }
+
+  // Posição de e na ordem de iteração (e deve pertencer ao conjunto)
+  int index_of(int e) const {
+    assert(contains(e));
+    return (int)(std::lower_bound(ids(), ids() + count, (uint16_t)e) - ids());
+  }
+
+  // Mantém a capacidade já alocada, para reaproveitar o objeto entre construções
+  void clear() {
+    std::fill(words(), words() + num_words, 0);
+    count = 0;
+  }
+
+  std::size_t size() const {
+    return count;
+  }
+
+  bool empty() const {
+    return count == 0;
+  }
+
+  const_iterator begin() const {
+    return ids();
+  }
+
+  const_iterator end() const {
+    return ids() + count;
+  }
+};
+
+#endif  // SOLUTION_IDS_CPP
@@ -0,0 +1,119 @@
+#ifndef THREAD_POOL_CPP
+#define THREAD_POOL_CPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool fixo de threads para laços paralelos (parallel_for).
+// A thread que chama parallel_for também trabalha (worker 0), então um pool de
+// tamanho 1 não cria nenhuma thread e executa tudo de forma sequencial.
+class ThreadPool {
+ public:
+  using Task = std::function<void(int idx, int worker_id)>;
+
+ private:
+  std::vector<std::thread> workers;
+
+  std::mutex mtx;
+  std::condition_variable cv_work;
+  std::condition_variable cv_done;
+
+  const Task* task = nullptr;
+  std::atomic<int> next_idx{0};
+  int total = 0;
+  int pending = 0;          // workers que ainda não terminaram a rodada atual
+  unsigned generation = 0;  // incrementado a cada parallel_for
+  bool stop = false;
+
+  // Cada worker pega o próximo índice livre (balanceamento dinâmico)
+  void run_chunk(int worker_id) {
+    for (int i = next_idx.fetch_add(1); i < total; i = next_idx.fetch_add(1)) {
+      (*task)(i, worker_id);
+    }
+  }
+
+  void worker_loop(int worker_id) {
+    unsigned seen_generation = 0;
+
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv_work.wait(lock, [&] { return stop || generation != seen_generation; });
+
+        if (stop) return;
+
+        seen_generation = generation;
+      }
+
+      run_chunk(worker_id);
+
+      std::lock_guard<std::mutex> lock(mtx);
+      if (--pending == 0) {
+        cv_done.notify_one();
+      }
+    }
+  }
+
+ public:
+  // num_threads <= 0 usa todos os núcleos disponíveis
+  explicit ThreadPool(int num_threads = 0) {
+    if (num_threads <= 0) {
+      num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (int id = 1; id < num_threads; id++) {
+      workers.emplace_back(&ThreadPool::worker_loop, this, id);
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      stop = true;
+    }
+    cv_work.notify_all();
+
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+
+  int size() const {
+    return (int)workers.size() + 1;
+  }
+
+  // Executa fn(idx, worker_id) para idx em [0, n) e bloqueia até o fim.
+  // worker_id está em [0, size()) e pode indexar buffers locais de cada thread.
+  void parallel_for(int n, const Task& fn) {
+    if (workers.empty() || n <= 1) {
+      for (int i = 0; i < n; i++) fn(i, 0);
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      task = &fn;
+      total = n;
+      next_idx = 0;
+      pending = (int)workers.size();
+      generation++;
+    }
+    cv_work.notify_all();
+
+    run_chunk(0);
+
+    std::unique_lock<std::mutex> lock(mtx);
+    cv_done.wait(lock, [&] { return pending == 0; });
+    task = nullptr;
+  }
+};
+
+#endif  // THREAD_POOL_CPP
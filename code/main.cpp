@@ -1,64 +1,48 @@
 #include <iostream>
 
-#include "./GRASPTS/instance_i.cpp"
+#include "./Batch/batch_runner.cpp"
 #include "./Report/report-manager.cpp"
-#include "ACO/acokmis.cpp"
-#include "GRASPTS/graspts.cpp"
 #include "Intances/instances.cpp"
 #include "common.hpp"
 
-// Function to process ACO for a given instance
-// @param instance The instance to process
-void processACO(const Instance& instance, ReportManager& report_manager) {
-  ACOKMIS aco_kmis = ACOKMIS(
-      instance.get_connections(),
-      instance.get_num_elements_l(),
-      instance.get_num_elements_r());
+// Number of independent repetitions per instance
+const int GRASPTS_REPETITIONS = 10;
+const int ACO_REPETITIONS = 1;
 
-  auto exec_reports = aco_kmis.solve_kMIS(instance.get_k());
+// When true, the GRASPTs repetitions of an instance share their best solution (see GRASPTs::shared_best)
+const bool GRASPTS_COOPERATIVE = false;
 
-  Report report_instance(instance.get_connections(),
-                         instance.get_file_name(),
-                         instance.get_k(),
-                         exec_reports);
+// Threads per ACOKMIS run. 1 keeps every job single-threaded, one job per core. N > 1 (0: all cores)
+// builds the ants of each ACO run on N threads; it starts once N cores are free, so jobs and ACO threads
+// never exceed the pool. With THREAD_CPU only the ACO's calling thread is timed.
+const int ACO_THREADS = 1;
 
-  report_manager.add_reports(report_instance);
-}
-
-InstanceI mapACOInstanceToGRASPTsInstance(const Instance& i) {
-  InstanceI ni;
+// Instances read ahead in parallel while others are solved (-1: one per core), in path order
+const int INSTANCE_PREFETCH = -1;
 
-  ni.k = i.get_k();
+// Instances resident at once; the next one is admitted as soon as one finishes. Only these (plus the
+// ones being prefetched) stay in memory. 0 picks enough to keep the pool busy: ceil(threads / jobs per instance) + 1
+const int INSTANCE_WINDOW = 0;
 
-  ni.featuresF = i.get_connections();
+// Re-check every N-th reported objective value against the bitmaps (0 disables)
+const int REPORT_VERIFY_EVERY = 0;
 
-  for (int i = 0; i < sz(ni.featuresF); ++i) {
-    ni.indicesE.push_back(i);
-  }
-
-  return ni;
-}
+// CSV (result-N.csv) or COLUMNAR (result-N.kres, faster to write and load for long traces)
+const ReportFormat REPORT_FORMAT = ReportFormat::CSV;
 
-// Function to process GRASP+Tabu Search for a given instance
-// @param instance The instance to process
-void processGRASPTs(const Instance& instance, ReportManager& report_manager) {
-  InstanceI I = mapACOInstanceToGRASPTsInstance(instance);
+// AUTO runs the solvers on a fixed-size DenseSubset when |R| <= 1024, ROARING always uses roaring::Roaring
+const SubsetBackend SUBSET_BACKEND = SubsetBackend::AUTO;
 
-  vector<ReportExecData> results;
+// Stopping criteria of every run: the first one reached stops it (0 disables the limit).
+// THREAD_CPU measures the CPU time of the job's thread, so runs sharing cores stay comparable.
+const BudgetClock BUDGET_CLOCK = BudgetClock::WALL;
+const double TIME_LIMIT_MS = 40000;
+const uint64_t MAX_EVALUATIONS = 0;
 
-  for (int iter = 0; iter < 10; iter++) {
-    GRASPTs graspts = GRASPTs(I);
-    auto result = graspts.solve_kMIS();
-    results.insert(results.end(), result.begin(), result.end());
-  }
-
-  Report report_instance(instance.get_connections(),
-                         instance.get_file_name(),
-                         instance.get_k(),
-                         results);
-
-  report_manager.add_reports(report_instance);
-}
+// Campaign seed: every GRASPTs run draws from a counter-based stream keyed by (seed, instance, repetition),
+// so results do not depend on the number of threads or on the job order. ACOKMIS builds its ants
+// greedily (highest transition probability) and uses no random numbers.
+const uint64_t RNG_SEED = 20240601;
 
 int main() {
 #ifndef DEBUG
@@ -67,22 +51,22 @@ int main() {
 #endif
 
   IntancesReader reader = IntancesReader();
-  const auto& instances = reader.get_instances();
-
-  ReportManager report_manager_graspts = ReportManager("graspts");
-
-  int instance_idx = 0;
-  for (auto instance : instances) {
-    instance_idx++;
-
-    processGRASPTs(instance, report_manager_graspts);
-  }
-
-  ReportManager report_manager_aco = ReportManager("aco_kmis");
-
-  instance_idx = 0;
-  for (auto instance : instances) {
-    instance_idx++;
-    processACO(instance, report_manager_aco);
-  }
-}
\ No newline at end of file
+  InstanceStream instances = reader.stream(INSTANCE_PREFETCH);
+
+  ReportManager report_manager_graspts = ReportManager("graspts", REPORT_VERIFY_EVERY, REPORT_FORMAT);
+  ReportManager report_manager_aco = ReportManager("aco_kmis", REPORT_VERIFY_EVERY, REPORT_FORMAT);
+
+  // Every (algorithm, instance, repetition) is a job on a pool with one pinned thread per core
+  BatchRunner runner(report_manager_graspts,
+                     report_manager_aco,
+                     GRASPTS_REPETITIONS,
+                     ACO_REPETITIONS,
+                     GRASPTS_COOPERATIVE,
+                     0,
+                     SUBSET_BACKEND,
+                     BudgetSpec{BUDGET_CLOCK, TIME_LIMIT_MS, MAX_EVALUATIONS},
+                     RNG_SEED,
+                     ACO_THREADS);
+
+  runner.run(instances, INSTANCE_WINDOW);
+}
@@ -7,7 +7,7 @@ echo ============================================
 echo.
 
 echo Compilando projeto...
-g++ -std=c++17 -O3 -fno-inline -o main.exe main.cpp bibliotecas/roaring.c -lpsapi
+g++ -std=c++17 -O3 -march=native -fno-inline -pthread -o main.exe main.cpp bibliotecas/roaring.c -lpsapi
 if %ERRORLEVEL% equ 0 (
     echo [OK] Compilação bem-sucedida!
     echo.
@@ -8,7 +8,7 @@ echo "============================================"
 echo ""
 
 echo "Compilando projeto..."
-g++ -std=c++17 -O3 -fno-inline -o main main.cpp bibliotecas/roaring.c
+g++ -std=c++17 -O3 -march=native -fno-inline -pthread -o main main.cpp bibliotecas/roaring.c
 if [ $? -eq 0 ]; then
     echo "[OK] Compilação bem-sucedida!"
     echo ""
@@ -7,7 +7,7 @@ echo ============================================
 echo.
 
 echo Compilando projeto com símbolos de debug...
-g++ -std=c++17 -g -O0 -DDEBUG -Wall -Wextra -o main_debug.exe main.cpp bibliotecas/roaring.c -lpsapi
+g++ -std=c++17 -g -O0 -DDEBUG -Wall -Wextra -pthread -o main_debug.exe main.cpp bibliotecas/roaring.c -lpsapi
 if %ERRORLEVEL% equ 0 (
     echo [OK] Compilação bem-sucedida!
     echo.